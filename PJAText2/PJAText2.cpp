@@ -2,6 +2,9 @@
 
 #include "Engine.h"
 #include "app_commands.h"
+#include "output_sink.h"
+#include "batch.h"
+#include "server.h"
 
 
 /**
@@ -16,19 +19,32 @@ Engine create_engine() {
         ->add(OperationalCommands::CountLines())
         ->add(OperationalCommands::CountNumbers())
         ->add(OperationalCommands::CountWords())
+        ->add(OperationalCommands::CountDistinctWords())
         ->add(OperationalCommands::ShowAnagrams())
         ->add(OperationalCommands::ShowFileSize())
         ->add(OperationalCommands::ShowPalindromes())
         ->add(OperationalCommands::ShowWords())
         ->add(OperationalCommands::ShowWordsReverse())
-        ->add(ModifyingCommands::WordsConsiderLength());
+        ->add(OperationalCommands::ShowFrequency())
+        ->add(OperationalCommands::ShowHeavyHitters())
+        ->add(OperationalCommands::EstimateWordCounts())
+        ->add(ModifyingCommands::WordsConsiderLength())
+        ->add(ModifyingCommands::WordsTop())
+        ->add(ModifyingCommands::MemoryLimit())
+        ->add(ModifyingCommands::TempDirectory())
+        ->add(ModifyingCommands::CacheDirectory())
+        ->add(ModifyingCommands::CacheSize())
+        ->add(ModifyingCommands::CacheStatOnly())
+        ->add(ModifyingCommands::CountersCheckpoint());
 
     return engine;
 }
 
 
 /**
- * @brief Executes the Engine on flags provided from the arguments
+ * @brief Executes the Engine on flags provided from the arguments,
+ * or all the instructions from a manifest file in the batch mode (-b manifest),
+ * or the instructions sent over a Unix domain socket in the server mode (-srv socket)
  *
  * @param argc - amount of arguments
  * @param argv - arguments
@@ -42,10 +58,39 @@ int main(int argc, char** argv)
         args.push_back(argv[i]);
     }
 
-    auto engine = create_engine();
-    auto res = engine.execute(args);
+    const auto engine = create_engine();
+    auto sink = OutputSink::standard_output();
 
-    std::cout << res;
+    if (!args.empty() && (args[0] == Batch::CALLER_VALUE || args[0] == Batch::ALIAS_VALUE)) {
+        if (args.size() != 2) {
+            sink->stream() << "[ERROR]: <BATCH> Batch flag requires a manifest file and should be the only one!\n";
+            return 0;
+        }
+
+        auto jobs = Batch::read_manifest(args[1]);
+        if (jobs.is_none()) {
+            sink->stream() << "[ERROR]: <BATCH> Manifest file is invalid!\n";
+            return 0;
+        }
+
+        Batch::run(jobs.get_value(), engine, sink->stream());
+        return 0;
+    }
+
+    if (!args.empty() && (args[0] == Server::CALLER_VALUE || args[0] == Server::ALIAS_VALUE)) {
+        if (args.size() != 2) {
+            sink->stream() << "[ERROR]: <SERVER> Server flag requires a socket path and should be the only one!\n";
+            return 0;
+        }
+
+        if (!Server::run(args[1], engine)) {
+            sink->stream() << "[ERROR]: <SERVER> Can't listen on the socket!\n";
+        }
+
+        return 0;
+    }
+
+    engine.execute(args, sink->stream());
 
     return 0;
 }
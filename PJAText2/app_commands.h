@@ -6,6 +6,12 @@
 #include <functional>
 
 #include "engine.h"
+#include "tokenizer.h"
+#include "sorting.h"
+#include "external_sort.h"
+#include "frequency.h"
+#include "cardinality.h"
+#include "heavy_hitters.h"
 
 
 namespace __Helpers {
@@ -24,30 +30,59 @@ namespace __Helpers {
 		}
 
 		/**
-		 * @brief Create a StringStream with the flag's name prefix and values of Vec<T> as a visual structure.
+		 * @brief Write the values of Vec<T> as a visual structure into the stream.
 		 *
 		 * @tparam T - Type of values in the "collection" argument's Vec
-		 * @param flag - target Flag instance
+		 * @param stream - destination stream
 		 * @param collection - target Vec with values to add into the visual structure
-		 * @return newly created StringStream
 		 */
 		template <typename T>
-		auto flag_string_stream_structure(const Flag& flag, const Vec<T>& collection) {
-			auto ss = flag_string_stream(flag);
-
+		void write_structure(std::ostream& stream, const Vec<T>& collection) {
 			if (collection.empty()) {
-				ss << "{ }";
+				stream << "{ }";
 			}
 			else {
-				ss << "{\n";
+				stream << "{\n";
 				for (const T& word : collection) {
-					ss << "    \"" << word << "\",\n";
+					stream << "    \"" << word << "\",\n";
 				}
-				ss << "}";
+				stream << "}";
 			}
+		}
+
+		/**
+		 * @brief Create a StringStream with the flag's name prefix and values of Vec<T> as a visual structure.
+		 *
+		 * @tparam T - Type of values in the "collection" argument's Vec
+		 * @param flag - target Flag instance
+		 * @param collection - target Vec with values to add into the visual structure
+		 * @return newly created StringStream
+		 */
+		template <typename T>
+		auto flag_string_stream_structure(const Flag& flag, const Vec<T>& collection) {
+			auto ss = flag_string_stream(flag);
+			write_structure(ss, collection);
 
 			return ss;
 		}
+
+		/**
+		 * @brief Create the Output writing the flag's name prefix and the words as a visual structure straight into the destination stream.
+		 * The words are views, so they have to point into the source, which is alive until the Outputs are grabbed.
+		 *
+		 * @param flag - target Flag instance
+		 * @param words - words to add into the visual structure
+		 * @return Output with a writer
+		 */
+		Output flag_structure_output(const Flag& flag, Tokenizer::Tokens words) {
+			const String prefix = flag_string_stream(flag).str();
+			const auto shared_words = std::make_shared<const Tokenizer::Tokens>(std::move(words));
+
+			return Output::new_ok_writer([prefix, shared_words](std::ostream& stream) {
+				stream << prefix;
+				write_structure(stream, *shared_words);
+			});
+		}
 	}
 
 	namespace Regex {
@@ -99,96 +134,178 @@ namespace __Helpers {
 
 		/**
 		 * @brief Grabs all the "words" in a String.
+		 * Same result as matching "(?!\\s)[\\S]+", but done by the Tokenizer instead of the regex engine.
 		 *
 		 * @param target - String instance to grab the "words"
 		 * @return Vec<String> collection with all the found "words"
 		 */
 		Vec<String> get_words(const String& target) {
-			return __Helpers::Regex::matches_to_vec(
-				target,
-				"(?!\\s)[\\S]+"
-			);
+			auto words = Vec<String>();
+
+			for (const StringView word : Tokenizer::split(target)) {
+				words.emplace_back(word);
+			}
+
+			return words;
 		}
 	}
 
-	namespace Comparators {
+	namespace Parse {
 		/**
-		 * @brief Returns the "greater comparator" of one type values with or without considering their size.
+		 * @brief Parses a size in bytes with an optional unit suffix (K, M, G, T), ex: "512M" or "2G".
 		 *
-		 * @tparam T - Type of the values that will be compared
-		 * @param as_size - Should the comparator consider the greater value by their .size() method
-		 * @return The lambda comparator of two borrowed const values of the same type
+		 * @param text - size in String representation
+		 * @return Option<usize>(Some) - If the size is valid and not zero
+		 * @return Option<usize>(None) - If the size is invalid, or too large
 		 */
-		template <typename T>
-		std::function<bool(const T&, const T&)> get_default(const bool as_size) {
-			if (as_size) {
-				return [](const T& left, const T& right) {
-					return left.size() < right.size();
-				};
+		Option<usize> size(const String& text) {
+			usize digits = 0;
+			usize value = 0;
+
+			while (digits < text.size() && text[digits] >= '0' && text[digits] <= '9') {
+				if (value > (SIZE_MAX - (text[digits] - '0')) / 10) {
+					return Option<usize>::none();
+				}
+
+				value = value * 10 + (text[digits] - '0');
+				digits++;
 			}
 
-			return [](const T& left, const T& right) {
-				return left < right;
-			};
+			auto unit = text.substr(digits);
+			if (!unit.empty() && (unit.back() == 'B' || unit.back() == 'b')) {
+				unit.pop_back();
+			}
+
+			usize multiplier = 1;
+			if (unit == "K" || unit == "k") multiplier = 1024ull;
+			else if (unit == "M" || unit == "m") multiplier = 1024ull * 1024;
+			else if (unit == "G" || unit == "g") multiplier = 1024ull * 1024 * 1024;
+			else if (unit == "T" || unit == "t") multiplier = 1024ull * 1024 * 1024 * 1024;
+			else if (!unit.empty()) return Option<usize>::none();
+
+			if (digits == 0 || value == 0 || value > SIZE_MAX / multiplier) {
+				return Option<usize>::none();
+			}
+
+			return Option<usize>::some(value * multiplier);
 		}
 
 		/**
-		 * @brief Returns the "reverse comparator" of one type values with or without considering their size.
+		 * @brief Parses a positive whole number, ex: "100".
 		 *
-		 * @tparam T - Type of the values that will be compared
-		 * @param as_size - Should the comparator consider the lower value by their .size() method
-		 * @return The lambda comparator of two borrowed const values of the same type
+		 * @param text - number in String representation
+		 * @return Option<usize>(Some) - If the number is valid and not zero
+		 * @return Option<usize>(None) - If the number is invalid, or too large
 		 */
-		template <typename T>
-		std::function<bool(const T&, const T&)> get_reverse(const bool as_size) {
-			if (as_size) {
-				return [](const T& left, const T& right) {
-					return left.size() > right.size();
-				};
+		Option<usize> count(const String& text) {
+			usize value = 0;
+
+			for (const char ch : text) {
+				if (ch < '0' || ch > '9' || value > (SIZE_MAX - (ch - '0')) / 10) {
+					return Option<usize>::none();
+				}
+
+				value = value * 10 + (ch - '0');
 			}
 
-			return [](const T& left, const T& right) {
-				return left > right;
-			};
+			if (value == 0) {
+				return Option<usize>::none();
+			}
+
+			return Option<usize>::some(value);
 		}
 	}
 
-	namespace Strings {
+	namespace Listings {
 		/**
-		 * @brief Checks if two Strings are anagrams.
+		 * @brief Sorts all the words from the source and creates the Output with their visual structure.
+		 * With the memory limit set, the words are sorted by the external merge sort instead of in the memory,
+		 * and the runs are merged straight into the destination stream.
+		 * With the limit set, only the top words are selected and sorted.
 		 *
-		 * @param first - Copy of the first String
-		 * @param second - Copy of the second String
-		 * @return true - if the two Strings are anagrams
-		 * @return false - if the two Strings aren't anagrams
+		 * @param flag - target Flag instance, sorts by the length if it's mod value is 1, lists at most limit words if it's not 0
+		 * @param operations - Struct holding operational data
+		 * @param descending - true for the reverse order
+		 * @return Output with a structure of sorted words
 		 */
-		bool are_anagrams(String first, String second) {
-			if (first.size() != second.size()) {
-				return false;
+		Output sorted_words(const Flag& flag, Operations& operations, const bool descending) {
+			if (operations.memory_limit == 0) {
+				auto words = operations.get_words();
+
+				if (flag.limit != 0) {
+					Sorting::top_words(words, flag.limit, flag.mod == 1, descending);
+				}
+				else {
+					Sorting::sort_words(words, flag.mod == 1, descending);
+				}
+
+				return Info::flag_structure_output(flag, std::move(words));
+			}
+
+			const auto settings = ExternalSort::Settings{
+				operations.memory_limit,
+				operations.temp_dir,
+				flag.mod == 1,
+				descending,
+				flag.limit
+			};
+
+			auto runs = ExternalSort::SortedRuns::sort(operations.source, settings);
+			auto readers = std::make_shared<Vec<IFStream>>();
+
+			if (runs == nullptr || !runs->open(*readers)) {
+				auto ss = Info::flag_string_stream(flag);
+				ss << "Can't write or read the temporary files!";
+
+				return Output::new_err(ss.str());
 			}
 
-			std::sort(first.begin(), first.end());
-			std::sort(second.begin(), second.end());
+			const String prefix = Info::flag_string_stream(flag).str();
+
+			return Output::new_ok_writer([prefix, runs, readers](std::ostream& stream) {
+				usize count = 0;
+				stream << prefix;
+
+				const bool merged = runs->merge(*readers, [&stream, &count](const StringView word) {
+					if (count++ == 0) {
+						stream << "{\n";
+					}
+
+					stream << "    \"" << word << "\",\n";
+				});
 
-			return first == second;
+				stream << (count == 0 ? "{ }" : "}");
+
+				// The listing is already being written, so a failed read is reported right after it
+				if (!merged) {
+					stream << "\n[ERROR]: " << prefix << "Can't read the temporary files!";
+				}
+			});
 		}
+	}
 
+	namespace Strings {
 		/**
-		 * @brief Checks if two Strings are palindromes.
+		 * @brief Gets the anagram signature of a String, which is the same for all of it's anagrams.
 		 *
-		 * @param first - const reference of the first String
-		 * @param second - Copy of the second String
-		 * @return true - if the two Strings are palindromes
-		 * @return false - if the two Strings aren't palindromes
+		 * @param word - view of the String
+		 * @return String with the sorted bytes of the word
 		 */
-		bool are_palindromes(const String& first, String second) {
-			if (first.size() != second.size()) {
-				return false;
-			}
+		String anagram_signature(const StringView word) {
+			auto signature = String(word);
+			std::sort(signature.begin(), signature.end());
 
-			std::reverse(second.begin(), second.end());
+			return signature;
+		}
 
-			return first == second;
+		/**
+		 * @brief Reverses the String.
+		 *
+		 * @param word - view of the String
+		 * @return reversed copy of the String
+		 */
+		String reversed(const StringView word) {
+			return String(word.rbegin(), word.rend());
 		}
 	}
 }
@@ -202,6 +319,41 @@ namespace __Helpers {
  */
 namespace BaseCommands {
 
+	/**
+	 * @brief Command responsible for switching the Engine into the stream mode.
+	 * In the stream mode the source file is never loaded as a whole, it's read in fixed-size chunks instead.
+	 */
+	struct StreamMode : Command {
+		static const String CALLER_VALUE;
+		static const String ALIAS_VALUE;
+
+		String caller() const override {
+			return CALLER_VALUE;
+		}
+
+		String alias() const override {
+			return ALIAS_VALUE;
+		}
+
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool affects_results() const override {
+			return false;
+		}
+
+		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			operations.is_streaming = true;
+			return Output::new_ok("");
+		}
+
+		Output execute(const Flag& flag, Operations& operations) const override {
+			return Output::new_ok("");
+		}
+	};
+
+
 	/**
 	 * @brief Command responsible for getting the content of the source file.
 	 */
@@ -218,15 +370,25 @@ namespace BaseCommands {
 			return ALIAS_VALUE;
 		}
 
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool affects_results() const override {
+			return false;
+		}
+
 		/**
 		 * @brief Checks if the Flag's argument is present, or the file exists.
+		 * The source is not loaded in the stream mode.
 		 *
 		 * @param flag - Flag instance of this specific command
+		 * @param inst - Instruction with all the Flags
 		 * @param operations - Struct holding operational data
 		 * @return Output(Error) - If Flag doesn't have an argument, or the argument is invalid
 		 * @return Output(Ok) - If succeeded
 		 */
-		Output validate(const Flag& flag, Instruction&, Operations& operations) const override {
+		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
 			auto ss = __Helpers::Info::flag_string_stream(flag);
 
 			if (flag.arg.empty()) {
@@ -240,7 +402,10 @@ namespace BaseCommands {
 			}
 
 			operations.file_in = flag.arg;
-			operations.source = File::read_unchecked(operations.file_in);
+
+			if (!inst.flag_exists(StreamMode::CALLER_VALUE, StreamMode::ALIAS_VALUE)) {
+				operations.load_source(operations.file_in);
+			}
 
 			return Output::new_ok("");
 		}
@@ -267,6 +432,10 @@ namespace BaseCommands {
 			return ALIAS_VALUE;
 		}
 
+		bool is_streamable() const override {
+			return true;
+		}
+
 		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
 			return Output::new_ok("");
 		}
@@ -292,6 +461,14 @@ namespace BaseCommands {
 			return ALIAS_VALUE;
 		}
 
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool affects_results() const override {
+			return false;
+		}
+
 		/**
 		 * @brief Checks if the flag has an argument, and saves the file name.
 		 *
@@ -317,6 +494,8 @@ namespace BaseCommands {
 		}
 	};
 
+	const String StreamMode::CALLER_VALUE = "-st";
+	const String StreamMode::ALIAS_VALUE = "--stream";
 	const String SourceFile::CALLER_VALUE = "-f";
 	const String SourceFile::ALIAS_VALUE = "--file";
 	const String InputFile::CALLER_VALUE = "-i";
@@ -347,7 +526,16 @@ namespace OperationalCommands {
 			return "--newlines";
 		}
 
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool is_read_only() const override {
+			return true;
+		}
+
 		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			operations.wants_statistics = true;
 			return Output::new_ok("");
 		}
 
@@ -361,11 +549,7 @@ namespace OperationalCommands {
 		Output execute(const Flag& flag, Operations& operations) const override {
 			auto ss = __Helpers::Info::flag_string_stream(flag);
 
-			ss << "New lines: " << std::count(
-				operations.source.begin(),
-				operations.source.end(),
-				'\n'
-			);
+			ss << "New lines: " << operations.get_statistics().lines;
 
 			return Output::new_ok(ss.str());
 		}
@@ -377,8 +561,6 @@ namespace OperationalCommands {
 	 */
 	struct CountDigits : Command
 	{
-		char digits[10] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9' };
-
 		String caller() const override {
 			return "-d";
 		}
@@ -387,7 +569,16 @@ namespace OperationalCommands {
 			return "--digits";
 		}
 
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool is_read_only() const override {
+			return true;
+		}
+
 		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			operations.wants_statistics = true;
 			return Output::new_ok("");
 		}
 
@@ -401,31 +592,10 @@ namespace OperationalCommands {
 		Output execute(const Flag& flag, Operations& operations) const override {
 			auto ss = __Helpers::Info::flag_string_stream(flag);
 
-			ss << "Digits: " << std::count_if(
-				operations.source.begin(),
-				operations.source.end(),
-				[this](const char ch) {
-				return is_digit(ch);
-			}
-			);
+			ss << "Digits: " << operations.get_statistics().digits;
 
 			return Output::new_ok(ss.str());
 		}
-
-		/**
-		 * @brief Checks if the specific char is a digit.
-		 *
-		 * @param ch - target char
-		 * @return true - if the char is a digit
-		 * @return false - if the char is not a digit
-		 */
-		bool is_digit(const char ch) const {
-			return std::find(
-				std::begin(digits),
-				std::end(digits),
-				ch
-			) != std::end(digits);
-		}
 	};
 
 
@@ -442,7 +612,16 @@ namespace OperationalCommands {
 			return "--numbers";
 		}
 
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool is_read_only() const override {
+			return true;
+		}
+
 		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			operations.wants_statistics = true;
 			return Output::new_ok("");
 		}
 
@@ -456,10 +635,7 @@ namespace OperationalCommands {
 		Output execute(const Flag& flag, Operations& operations) const override {
 			auto ss = __Helpers::Info::flag_string_stream(flag);
 
-			ss << "Numbers: " << __Helpers::Regex::count_matches(
-				operations.source,
-				"(^|\\s)[0-9]+(?!\\w)"
-			);
+			ss << "Numbers: " << operations.get_statistics().numbers;
 
 			return Output::new_ok(ss.str());
 		}
@@ -479,7 +655,16 @@ namespace OperationalCommands {
 			return "--chars";
 		}
 
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool is_read_only() const override {
+			return true;
+		}
+
 		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			operations.wants_statistics = true;
 			return Output::new_ok("");
 		}
 
@@ -493,7 +678,7 @@ namespace OperationalCommands {
 		Output execute(const Flag& flag, Operations& operations) const override {
 			auto ss = __Helpers::Info::flag_string_stream(flag);
 
-			ss << "Chars: " << operations.source.length() - 1;
+			ss << "Chars: " << operations.get_statistics().chars - 1;
 
 			return Output::new_ok(ss.str());
 		}
@@ -513,7 +698,16 @@ namespace OperationalCommands {
 			return "--words";
 		}
 
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool is_read_only() const override {
+			return true;
+		}
+
 		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			operations.wants_statistics = true;
 			return Output::new_ok("");
 		}
 
@@ -527,10 +721,88 @@ namespace OperationalCommands {
 		Output execute(const Flag& flag, Operations& operations) const override {
 			auto ss = __Helpers::Info::flag_string_stream(flag);
 
-			ss << "Words: " << __Helpers::Regex::count_matches(
-				operations.source,
-				"(?!\\s)[\\S]+"
-			);
+			ss << "Words: " << operations.get_statistics().words;
+
+			return Output::new_ok(ss.str());
+		}
+	};
+
+
+	/**
+	 * @brief Command responsible for estimating the amount of distinct words in the source file.
+	 * The estimate comes from a HyperLogLog sketch, so it needs a fixed amount of memory no matter how large the source is.
+	 */
+	struct CountDistinctWords : Command
+	{
+		String caller() const override {
+			return "-u";
+		}
+
+		String alias() const override {
+			return "--unique";
+		}
+
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool is_read_only() const override {
+			return true;
+		}
+
+		/**
+		 * @brief Gets the precision of the sketch from the flag's argument.
+		 *
+		 * @param flag - Flag instance of this specific command
+		 * @return Option<u8>(Some) - If the argument is empty (default precision), or a valid precision
+		 * @return Option<u8>(None) - If the argument is invalid
+		 */
+		static Option<u8> precision(const Flag& flag) {
+			if (flag.arg.empty()) {
+				return Option<u8>::some(Cardinality::DEFAULT_PRECISION);
+			}
+
+			auto value = __Helpers::Parse::count(flag.arg);
+			if (value.is_none() || value.get_value() < Cardinality::MIN_PRECISION || value.get_value() > Cardinality::MAX_PRECISION) {
+				return Option<u8>::none();
+			}
+
+			return Option<u8>::some((u8)value.get_value());
+		}
+
+		/**
+		 * @brief Checks if the optional argument is a valid precision of the sketch.
+		 *
+		 * @param flag - Flag instance of this specific command
+		 * @param operations - Struct holding operational data
+		 * @return Output(Error) - If the argument is not a valid precision
+		 * @return Output(Ok) - If succeeded
+		 */
+		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			if (precision(flag).is_none()) {
+				auto ss = __Helpers::Info::flag_string_stream(flag);
+				ss << "This flag requires a precision from " << (i32)Cardinality::MIN_PRECISION
+					<< " to " << (i32)Cardinality::MAX_PRECISION << " as an argument, or none!";
+
+				return Output::new_err(ss.str());
+			}
+
+			operations.distinct_precision = precision(flag).get_value();
+			return Output::new_ok("");
+		}
+
+		/**
+		 * @brief Estimates the amount of distinct words in the source file.
+		 * In the stream mode the words are sketched in the same read of the source file as the counters.
+		 *
+		 * @param flag - Flag instance of this specific command
+		 * @param operations - Struct holding operational data
+		 * @return Output with an estimated number of distinct words in the source file
+		 */
+		Output execute(const Flag& flag, Operations& operations) const override {
+			auto ss = __Helpers::Info::flag_string_stream(flag);
+
+			ss << "Distinct words: ~" << operations.get_distinct_sketch().estimate();
 
 			return Output::new_ok(ss.str());
 		}
@@ -549,6 +821,10 @@ namespace OperationalCommands {
 			return "--anagrams";
 		}
 
+		bool is_read_only() const override {
+			return true;
+		}
+
 		/**
 		 * @brief Checks if this flag is the last one, and if it contains an argument.
 		 *
@@ -575,34 +851,51 @@ namespace OperationalCommands {
 		}
 
 		/**
-		 * @brief Gets all the anagrams from the source file, and ereses the repeated values.
+		 * @brief Gets all the anagrams from the source file, without the repeated values.
+		 * The distinct source words are indexed once by their anagram signature,
+		 * so every word from the argument costs a single lookup.
 		 *
 		 * @param flag - Flag instance of this specific command
 		 * @param operations - Struct holding operational data
-		 * @return Output with a structure of found anagrams
+		 * @return Output with a structure of found anagrams, in the order of their first occurrence
 		 */
 		Output execute(const Flag& flag, Operations& operations) const override {
-			auto words_source = __Helpers::Regex::get_words(operations.source);
-			auto words_flag = __Helpers::Regex::get_words(flag.arg);
+			const auto& words_source = operations.get_words();
+			auto words_flag = Tokenizer::split(flag.arg);
 
-			auto anagrams = Vec<String>();
+			auto distinct = Tokenizer::Tokens();
+			auto positions = HashMap<StringView, usize>();
+			auto index = HashMap<String, Vec<usize>>();
 
-			for (String& first : words_source) {
-				for (String& second : words_flag) {
-					if (__Helpers::Strings::are_anagrams(first, second)) {
-						anagrams.push_back(first);
-					}
+			for (const StringView word : words_source) {
+				if (positions.emplace(word, distinct.size()).second) {
+					index[__Helpers::Strings::anagram_signature(word)].push_back(distinct.size());
+					distinct.push_back(word);
 				}
 			}
 
-			anagrams.erase(
-				std::unique(anagrams.begin(), anagrams.end()),
-				anagrams.end()
-			);
+			auto found = Vec<usize>();
+
+			for (const StringView word : words_flag) {
+				auto entry = index.find(__Helpers::Strings::anagram_signature(word));
+
+				if (entry != index.end()) {
+					found.insert(found.end(), entry->second.begin(), entry->second.end());
+				}
+			}
 
-			return Output::new_ok(
-				__Helpers::Info::flag_string_stream_structure(flag, anagrams).str()
+			std::sort(found.begin(), found.end());
+			found.erase(
+				std::unique(found.begin(), found.end()),
+				found.end()
 			);
+
+			auto anagrams = Tokenizer::Tokens();
+			for (const usize position : found) {
+				anagrams.push_back(distinct[position]);
+			}
+
+			return __Helpers::Info::flag_structure_output(flag, std::move(anagrams));
 		}
 	};
 
@@ -619,6 +912,10 @@ namespace OperationalCommands {
 			return "--palindromes";
 		}
 
+		bool is_read_only() const override {
+			return true;
+		}
+
 		/**
 		 * @brief Checks if this flag is the last one, and if it contains an argument.
 		 *
@@ -645,34 +942,34 @@ namespace OperationalCommands {
 		}
 
 		/**
-		 * @brief Gets all the palindromes from the source file, and ereses the repeated values.
+		 * @brief Gets all the palindromes from the source file, without the repeated values.
+		 * The words from the argument are reversed once into a set,
+		 * so every source word costs a single lookup.
 		 *
 		 * @param flag - Flag instance of this specific command
 		 * @param operations - Struct holding operational data
-		 * @return Output with a structure of found palindromes
+		 * @return Output with a structure of found palindromes, in the order of their first occurrence
 		 */
 		Output execute(const Flag& flag, Operations& operations) const override {
-			auto words_source = __Helpers::Regex::get_words(operations.source);
-			auto words_flag = __Helpers::Regex::get_words(flag.arg);
+			const auto& words_source = operations.get_words();
+			auto words_flag = Tokenizer::split(flag.arg);
+
+			auto reversed_storage = Vec<String>();
+			for (const StringView word : words_flag) {
+				reversed_storage.push_back(__Helpers::Strings::reversed(word));
+			}
 
-			auto palindromes = Vec<String>();
+			auto reversed_words = HashSet<StringView>(reversed_storage.begin(), reversed_storage.end());
+			auto found = HashSet<StringView>();
+			auto palindromes = Tokenizer::Tokens();
 
-			for (String& first : words_source) {
-				for (String& second : words_flag) {
-					if (__Helpers::Strings::are_palindromes(first, second)) {
-						palindromes.push_back(first);
-					}
+			for (const StringView word : words_source) {
+				if (reversed_words.count(word) != 0 && found.insert(word).second) {
+					palindromes.push_back(word);
 				}
 			}
 
-			palindromes.erase(
-				std::unique(palindromes.begin(), palindromes.end()),
-				palindromes.end()
-			);
-
-			return Output::new_ok(
-				__Helpers::Info::flag_string_stream_structure(flag, palindromes).str()
-			);
+			return __Helpers::Info::flag_structure_output(flag, std::move(palindromes));
 		}
 	};
 
@@ -693,6 +990,10 @@ namespace OperationalCommands {
 			return ALIAS_VALUE;
 		}
 
+		bool is_read_only() const override {
+			return true;
+		}
+
 		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
 			return Output::new_ok("");
 		}
@@ -705,17 +1006,7 @@ namespace OperationalCommands {
 		 * @return Output with a structure of found words
 		 */
 		Output execute(const Flag& flag, Operations& operations) const override {
-			auto words = __Helpers::Regex::get_words(operations.source);
-
-			std::sort(
-				words.begin(),
-				words.end(),
-				__Helpers::Comparators::get_default<String>(flag.mod == 1)
-			);
-
-			return Output::new_ok(
-				__Helpers::Info::flag_string_stream_structure(flag, words).str()
-			);
+			return __Helpers::Listings::sorted_words(flag, operations, false);
 		}
 	};
 
@@ -735,6 +1026,10 @@ namespace OperationalCommands {
 			return ALIAS_VALUE;
 		}
 
+		bool is_read_only() const override {
+			return true;
+		}
+
 		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
 			return Output::new_ok("");
 		}
@@ -747,17 +1042,7 @@ namespace OperationalCommands {
 		 * @return Output with a structure of found words
 		 */
 		Output execute(const Flag& flag, Operations& operations) const override {
-			auto words = __Helpers::Regex::get_words(operations.source);
-
-			std::sort(
-				words.begin(),
-				words.end(),
-				__Helpers::Comparators::get_reverse<String>(flag.mod == 1)
-			);
-
-			return Output::new_ok(
-				__Helpers::Info::flag_string_stream_structure(flag, words).str()
-			);
+			return __Helpers::Listings::sorted_words(flag, operations, true);
 		}
 	};
 
@@ -776,6 +1061,14 @@ namespace OperationalCommands {
 			return "--size";
 		}
 
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool is_read_only() const override {
+			return true;
+		}
+
 		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
 			return Output::new_ok("");
 		}
@@ -812,31 +1105,323 @@ namespace OperationalCommands {
 		}
 	};
 
-	const String ShowWords::CALLER_VALUE = "-s";
-	const String ShowWords::ALIAS_VALUE = "--sorted";
-	const String ShowWordsReverse::CALLER_VALUE = "-rs";
-	const String ShowWordsReverse::ALIAS_VALUE = "--reverse-sorted";
-}
-
-
-/**
- * @brief Modifying commands changing functionality of the other commands.
- *  Flexible.
- *  Can be modified.
- *  Have to be added manually by the Engine::add function.
- */
-namespace ModifyingCommands {
-
 	/**
-	 * @brief Command responsible for modifying ShowWords and ShowWordsReverse commands by changing their sort target to .size() method.
+	 * @brief Command responsible for counting the occurrences of every word from the source file.
 	 */
-	struct WordsConsiderLength : Command
-	{
-		const String CALLER_VALUE = "-l";
-		const String ALIAS_VALUE = "--by-length";
+	struct ShowFrequency : Command {
+		static const String CALLER_VALUE;
+		static const String ALIAS_VALUE;
 
 		String caller() const override {
-			return "-l";
+			return CALLER_VALUE;
+		}
+
+		String alias() const override {
+			return ALIAS_VALUE;
+		}
+
+		bool is_read_only() const override {
+			return true;
+		}
+
+		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			return Output::new_ok("");
+		}
+
+		/**
+		 * @brief Counts the occurrences of every word from the source file, and orders the words from the most frequent.
+		 *
+		 * @param flag - Flag instance of this specific command, lists at most limit words if it's not 0
+		 * @param operations - Struct holding operational data
+		 * @return Output with a structure of the words and their counts
+		 */
+		Output execute(const Flag& flag, Operations& operations) const override {
+			const auto counter = Frequency::count(operations.get_words());
+			const auto entries = std::make_shared<const Vec<Frequency::Entry>>(
+				Frequency::ranked(counter, flag.limit)
+			);
+
+			const String prefix = __Helpers::Info::flag_string_stream(flag).str();
+
+			return Output::new_ok_writer([prefix, entries](std::ostream& stream) {
+				stream << prefix;
+
+				if (entries->empty()) {
+					stream << "{ }";
+					return;
+				}
+
+				stream << "{\n";
+				for (const Frequency::Entry& entry : *entries) {
+					stream << "    \"" << entry.first << "\": " << entry.second << ",\n";
+				}
+				stream << "}";
+			});
+		}
+	};
+
+	/**
+	 * @brief Command responsible for finding the most frequent words of the source file in a bounded memory.
+	 */
+	struct ShowHeavyHitters : Command {
+		/**
+		 * @brief Number of the words listed without an argument.
+		 */
+		static const usize DEFAULT_COUNT = 10;
+
+		/**
+		 * @brief Largest number of the listed words, so the summary's memory stays bounded (CAPACITY_FACTOR words are monitored per each).
+		 */
+		static const usize MAX_COUNT = 100000;
+		static_assert(MAX_COUNT <= SIZE_MAX / HeavyHitters::CAPACITY_FACTOR, "The summary's capacity can't overflow");
+
+		String caller() const override {
+			return "-hh";
+		}
+
+		String alias() const override {
+			return "--heavy-hitters";
+		}
+
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool is_read_only() const override {
+			return true;
+		}
+
+		/**
+		 * @brief Gets the number of the listed words from the flag's argument.
+		 *
+		 * @param flag - Flag instance of this specific command
+		 * @return Option<usize>(Some) - If the argument is empty (default number), or a valid number
+		 * @return Option<usize>(None) - If the argument is invalid, or larger than MAX_COUNT
+		 */
+		static Option<usize> count(const Flag& flag) {
+			if (flag.arg.empty()) {
+				return Option<usize>::some(DEFAULT_COUNT);
+			}
+
+			auto value = __Helpers::Parse::count(flag.arg);
+			if (value.is_none() || value.get_value() > MAX_COUNT) {
+				return Option<usize>::none();
+			}
+
+			return value;
+		}
+
+		/**
+		 * @brief Checks if the optional argument is a valid number of the words.
+		 *
+		 * @param flag - Flag instance of this specific command
+		 * @param operations - Struct holding operational data
+		 * @return Output(Error) - If the argument is not a valid number
+		 * @return Output(Ok) - If succeeded
+		 */
+		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			if (count(flag).is_none()) {
+				auto ss = __Helpers::Info::flag_string_stream(flag);
+				ss << "This flag requires a number from 1 to " << MAX_COUNT << " as an argument, or none! (ex: 10)";
+
+				return Output::new_err(ss.str());
+			}
+
+			return Output::new_ok("");
+		}
+
+		/**
+		 * @brief Finds the most frequent words with the Space-Saving algorithm.
+		 * The counts are upper bounds, the possible overestimation is shown next to every inexact count.
+		 *
+		 * @param flag - Flag instance of this specific command
+		 * @param operations - Struct holding operational data
+		 * @return Output with a structure of the words and their counts
+		 */
+		Output execute(const Flag& flag, Operations& operations) const override {
+			const usize words = count(flag).get_value();
+			auto summary = HeavyHitters::SpaceSaving(words * HeavyHitters::CAPACITY_FACTOR);
+
+			operations.for_each_word([&summary](const StringView word) {
+				summary.add(word);
+			});
+
+			auto ss = __Helpers::Info::flag_string_stream(flag);
+			const auto entries = summary.top(words);
+
+			if (entries.empty()) {
+				ss << "{ }";
+				return Output::new_ok(ss.str());
+			}
+
+			ss << "{\n";
+			for (const HeavyHitters::Entry& entry : entries) {
+				ss << "    \"" << entry.word << "\": " << entry.count;
+
+				if (entry.error != 0) {
+					ss << " (max error " << entry.error << ")";
+				}
+
+				ss << ",\n";
+			}
+			ss << "}";
+
+			return Output::new_ok(ss.str());
+		}
+	};
+
+
+	/**
+	 * @brief Command responsible for estimating the counts of the specific words with a Count-Min sketch.
+	 */
+	struct EstimateWordCounts : Command {
+		String caller() const override {
+			return "-cm";
+		}
+
+		String alias() const override {
+			return "--count-min";
+		}
+
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool is_read_only() const override {
+			return true;
+		}
+
+		/**
+		 * @brief Checks if the flag has the words to estimate as an argument.
+		 *
+		 * @param flag - Flag instance of this specific command
+		 * @param operations - Struct holding operational data
+		 * @return Output(Error) - If Flag doesn't have an argument
+		 * @return Output(Ok) - If succeeded
+		 */
+		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			if (flag.arg.empty()) {
+				auto ss = __Helpers::Info::flag_string_stream(flag);
+				ss << "This flag requires an argument!";
+
+				return Output::new_err(ss.str());
+			}
+
+			return Output::new_ok("");
+		}
+
+		/**
+		 * @brief Counts all the words of the source file into a Count-Min sketch, and estimates the counts of the argument's words.
+		 * The estimates are never lower than the real counts.
+		 *
+		 * @param flag - Flag instance of this specific command
+		 * @param operations - Struct holding operational data
+		 * @return Output with a structure of the words and their estimated counts
+		 */
+		Output execute(const Flag& flag, Operations& operations) const override {
+			auto sketch = HeavyHitters::CountMin();
+
+			operations.for_each_word([&sketch](const StringView word) {
+				sketch.add(word);
+			});
+
+			auto ss = __Helpers::Info::flag_string_stream(flag);
+
+			ss << "{\n";
+			for (const StringView word : Tokenizer::split(flag.arg)) {
+				ss << "    \"" << word << "\": ~" << sketch.estimate(word) << ",\n";
+			}
+			ss << "}";
+
+			return Output::new_ok(ss.str());
+		}
+	};
+
+	const String ShowWords::CALLER_VALUE = "-s";
+	const String ShowWords::ALIAS_VALUE = "--sorted";
+	const String ShowWordsReverse::CALLER_VALUE = "-rs";
+	const String ShowWordsReverse::ALIAS_VALUE = "--reverse-sorted";
+	const String ShowFrequency::CALLER_VALUE = "-fq";
+	const String ShowFrequency::ALIAS_VALUE = "--frequency";
+}
+
+
+/**
+ * @brief Modifying commands changing functionality of the other commands.
+ *  Flexible.
+ *  Can be modified.
+ *  Have to be added manually by the Engine::add function.
+ */
+namespace ModifyingCommands {
+
+	namespace __Listing {
+		/**
+		 * @brief Names of the Flags modifying the next listing Flag, they can be chained in any order.
+		 */
+		const Vec<String> MODIFIER_NAMES = { "-l", "--by-length", "-t", "--top" };
+
+		/**
+		 * @brief Names of the Flags listing the sorted words.
+		 */
+		const Vec<String> SORTED_NAMES = {
+			OperationalCommands::ShowWordsReverse::CALLER_VALUE,
+			OperationalCommands::ShowWordsReverse::ALIAS_VALUE,
+			OperationalCommands::ShowWords::CALLER_VALUE,
+			OperationalCommands::ShowWords::ALIAS_VALUE
+		};
+
+		/**
+		 * @brief Names of the Flags listing the words with a limit.
+		 */
+		const Vec<String> LIMITED_NAMES = {
+			OperationalCommands::ShowWordsReverse::CALLER_VALUE,
+			OperationalCommands::ShowWordsReverse::ALIAS_VALUE,
+			OperationalCommands::ShowWords::CALLER_VALUE,
+			OperationalCommands::ShowWords::ALIAS_VALUE,
+			OperationalCommands::ShowFrequency::CALLER_VALUE,
+			OperationalCommands::ShowFrequency::ALIAS_VALUE
+		};
+
+		/**
+		 * @brief Finds the Flag modified by the modifier, skipping the other modifiers in between.
+		 *
+		 * @param flag - Flag instance of the modifier
+		 * @param inst - Instruction with all the Flags
+		 * @param names - names of the Flags that can be modified
+		 * @param ss - StringStream with the modifier's prefix for the error message
+		 * @param target - set to the pointer of the modified Flag
+		 * @return Output(Error) - If the next flag doesn't exists, or can't be modified
+		 * @return Output(Ok) - If the modified Flag was found
+		 */
+		Output find_target(const Flag& flag, Instruction& inst, const Vec<String>& names, StringStream& ss, Flag*& target) {
+			usize position = flag.pos + 1;
+			target = inst.get_flag_ptr(position);
+
+			while (target != nullptr && target->name_in(MODIFIER_NAMES)) {
+				target = inst.get_flag_ptr(++position);
+			}
+
+			if (target == nullptr) {
+				ss << "This flag can't be the last one!";
+				return Output::new_err(ss.str());
+			}
+
+			if (!target->name_in(names)) {
+				ss << "Missing required flag after this one!";
+				return Output::new_err(ss.str());
+			}
+
+			return Output::new_ok("");
+		}
+	}
+
+	/**
+	 * @brief Command responsible for modifying ShowWords and ShowWordsReverse commands by changing their sort target to .size() method.
+	 */
+	struct WordsConsiderLength : Command
+	{
+		String caller() const override {
+			return "-l";
 		}
 
 		String alias() const override {
@@ -844,47 +1429,371 @@ namespace ModifyingCommands {
 		}
 
 		/**
-		 * @brief Checks if the next flag is a ShowWords or ShowWordsReverse and changes it's mod value to 1.
+		 * @brief Checks if the next flag (after the other modifiers) is a ShowWords or ShowWordsReverse and changes it's mod value to 1.
 		 *
 		 * @param flag - Flag instance of this specific command
 		 * @param inst - Instruction with all the Flags
 		 * @param operations - Struct holding operational data
 		 * @return Output(Error) - If the next flag doesn't exists, or isn't a ShowWords or ShowWordsReverse
-		 * @return Output(Ok) - If the next flag is the same, or if modification succeeded
+		 * @return Output(Ok) - If the modification succeeded
 		 */
 		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
 			auto ss = __Helpers::Info::flag_string_stream(flag);
 
-			Flag* flag_after_ptr = inst.get_flag_ptr(flag.pos + 1);
+			Flag* target = nullptr;
+			auto output = __Listing::find_target(flag, inst, __Listing::SORTED_NAMES, ss, target);
 
-			WordsConsiderLength::ALIAS_VALUE;
+			if (output.is_err()) {
+				return output;
+			}
 
-			if (flag_after_ptr != nullptr) {
-				if (flag_after_ptr->name_in({
-					CALLER_VALUE,
-					ALIAS_VALUE
-					})) {
-					return Output::new_ok("");
-				}
+			target->mod = 1;
+			return Output::new_ok("");
+		}
 
-				if (!flag_after_ptr->name_in({
-					OperationalCommands::ShowWordsReverse::CALLER_VALUE,
-					OperationalCommands::ShowWordsReverse::ALIAS_VALUE,
-					OperationalCommands::ShowWords::CALLER_VALUE,
-					OperationalCommands::ShowWords::ALIAS_VALUE
-					})) {
-					ss << "Missing required flag after this one!";
-					return Output::new_err(ss.str());
-				}
-				else {
-					flag_after_ptr->mod = 1;
-				}
+		Output execute(const Flag& flag, Operations& operations) const override {
+			return Output::new_ok("");
+		}
+	};
+
+
+	/**
+	 * @brief Command responsible for limiting ShowWords, ShowWordsReverse and ShowFrequency commands to their first N words.
+	 * Only the listed words are sorted, the rest is dropped by a linear selection.
+	 */
+	struct WordsTop : Command
+	{
+		String caller() const override {
+			return "-t";
+		}
+
+		String alias() const override {
+			return "--top";
+		}
+
+		/**
+		 * @brief Checks if the flag has a valid number as an argument,
+		 * and if the next flag (after the other modifiers) is a ShowWords, ShowWordsReverse or ShowFrequency, and changes it's limit value.
+		 *
+		 * @param flag - Flag instance of this specific command
+		 * @param inst - Instruction with all the Flags
+		 * @param operations - Struct holding operational data
+		 * @return Output(Error) - If the argument is not a valid number, or the next flag doesn't exists, or isn't a ShowWords, ShowWordsReverse or ShowFrequency
+		 * @return Output(Ok) - If the modification succeeded
+		 */
+		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			auto ss = __Helpers::Info::flag_string_stream(flag);
+
+			auto limit = __Helpers::Parse::count(flag.arg);
+			if (limit.is_none()) {
+				ss << "This flag requires a positive number as an argument! (ex: 100)";
+				return Output::new_err(ss.str());
 			}
-			else {
-				ss << "This flag can't be the last one!";
+
+			Flag* target = nullptr;
+			auto output = __Listing::find_target(flag, inst, __Listing::LIMITED_NAMES, ss, target);
+
+			if (output.is_err()) {
+				return output;
+			}
+
+			target->limit = limit.get_value();
+			return Output::new_ok("");
+		}
+
+		Output execute(const Flag& flag, Operations& operations) const override {
+			return Output::new_ok("");
+		}
+	};
+
+
+	/**
+	 * @brief Command responsible for limiting the memory used by ShowWords and ShowWordsReverse commands.
+	 * With the limit set, the words are sorted by the external merge sort using the temporary files.
+	 */
+	struct MemoryLimit : Command
+	{
+		String caller() const override {
+			return "-m";
+		}
+
+		String alias() const override {
+			return "--mem-limit";
+		}
+
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool affects_results() const override {
+			return false;
+		}
+
+		/**
+		 * @brief Checks if the flag has a valid size as an argument, and saves it.
+		 *
+		 * @param flag - Flag instance of this specific command
+		 * @param operations - Struct holding operational data
+		 * @return Output(Error) - If Flag doesn't have an argument, or the argument is not a valid size
+		 * @return Output(Ok) - If succeeded
+		 */
+		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			auto ss = __Helpers::Info::flag_string_stream(flag);
+
+			auto limit = __Helpers::Parse::size(flag.arg);
+			if (limit.is_none()) {
+				ss << "This flag requires a size as an argument! (ex: 512M, 2G)";
+				return Output::new_err(ss.str());
+			}
+
+			operations.memory_limit = limit.get_value();
+			return Output::new_ok("");
+		}
+
+		Output execute(const Flag& flag, Operations& operations) const override {
+			return Output::new_ok("");
+		}
+	};
+
+
+	/**
+	 * @brief Command responsible for setting the directory of the temporary files.
+	 */
+	struct TempDirectory : Command
+	{
+		String caller() const override {
+			return "-tmp";
+		}
+
+		String alias() const override {
+			return "--tmp-dir";
+		}
+
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool affects_results() const override {
+			return false;
+		}
+
+		/**
+		 * @brief Checks if the flag has an existing directory as an argument, and saves it.
+		 *
+		 * @param flag - Flag instance of this specific command
+		 * @param operations - Struct holding operational data
+		 * @return Output(Error) - If Flag doesn't have an argument, or the directory doesn't exist
+		 * @return Output(Ok) - If succeeded
+		 */
+		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			auto ss = __Helpers::Info::flag_string_stream(flag);
+
+			if (flag.arg.empty()) {
+				ss << "This flag requires an argument!";
+				return Output::new_err(ss.str());
+			}
+
+			std::error_code error;
+			if (!std::filesystem::is_directory(flag.arg, error)) {
+				ss << "Provided directory doesn't exists!";
+				return Output::new_err(ss.str());
+			}
+
+			operations.temp_dir = flag.arg;
+			return Output::new_ok("");
+		}
+
+		Output execute(const Flag& flag, Operations& operations) const override {
+			return Output::new_ok("");
+		}
+	};
+
+
+	/**
+	 * @brief Command responsible for setting the directory of the result cache.
+	 * With the cache set, the Outputs of an instruction are stored, and returned again for the same source content and flags.
+	 */
+	struct CacheDirectory : Command
+	{
+		String caller() const override {
+			return "-ca";
+		}
+
+		String alias() const override {
+			return "--cache";
+		}
+
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool affects_results() const override {
+			return false;
+		}
+
+		/**
+		 * @brief Checks if the flag has a directory as an argument, creates it if needed, and saves it.
+		 *
+		 * @param flag - Flag instance of this specific command
+		 * @param operations - Struct holding operational data
+		 * @return Output(Error) - If Flag doesn't have an argument, or the directory can't be created
+		 * @return Output(Ok) - If succeeded
+		 */
+		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			auto ss = __Helpers::Info::flag_string_stream(flag);
+
+			if (flag.arg.empty()) {
+				ss << "This flag requires an argument!";
+				return Output::new_err(ss.str());
+			}
+
+			std::error_code error;
+			std::filesystem::create_directories(flag.arg, error);
+
+			if (!std::filesystem::is_directory(flag.arg, error)) {
+				ss << "Provided directory can't be created!";
+				return Output::new_err(ss.str());
+			}
+
+			operations.cache.directory = flag.arg;
+			return Output::new_ok("");
+		}
+
+		Output execute(const Flag& flag, Operations& operations) const override {
+			return Output::new_ok("");
+		}
+	};
+
+
+	/**
+	 * @brief Command responsible for limiting the size of the result cache.
+	 */
+	struct CacheSize : Command
+	{
+		String caller() const override {
+			return "-cs";
+		}
+
+		String alias() const override {
+			return "--cache-size";
+		}
+
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool affects_results() const override {
+			return false;
+		}
+
+		/**
+		 * @brief Checks if the flag has a valid size as an argument, and saves it.
+		 *
+		 * @param flag - Flag instance of this specific command
+		 * @param operations - Struct holding operational data
+		 * @return Output(Error) - If Flag doesn't have an argument, or the argument is not a valid size
+		 * @return Output(Ok) - If succeeded
+		 */
+		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			auto ss = __Helpers::Info::flag_string_stream(flag);
+
+			auto limit = __Helpers::Parse::size(flag.arg);
+			if (limit.is_none()) {
+				ss << "This flag requires a size as an argument! (ex: 512M, 2G)";
+				return Output::new_err(ss.str());
+			}
+
+			operations.cache.size_limit = limit.get_value();
+			return Output::new_ok("");
+		}
+
+		Output execute(const Flag& flag, Operations& operations) const override {
+			return Output::new_ok("");
+		}
+	};
+
+
+	/**
+	 * @brief Command responsible for validating the cached results only by the source file's modification time and size,
+	 * so an unchanged source file isn't read at all.
+	 */
+	struct CacheStatOnly : Command
+	{
+		String caller() const override {
+			return "-cst";
+		}
+
+		String alias() const override {
+			return "--cache-stat";
+		}
+
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool affects_results() const override {
+			return false;
+		}
+
+		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			operations.cache.stat_only = true;
+			return Output::new_ok("");
+		}
+
+		Output execute(const Flag& flag, Operations& operations) const override {
+			return Output::new_ok("");
+		}
+	};
+
+
+	/**
+	 * @brief Command responsible for setting the checkpoint file of the counters.
+	 * The counters of a source file that only grows (ex: a log) are resumed from the checkpoint,
+	 * so only the bytes appended since the previous execution are scanned.
+	 */
+	struct CountersCheckpoint : Command
+	{
+		String caller() const override {
+			return "-cp";
+		}
+
+		String alias() const override {
+			return "--checkpoint";
+		}
+
+		bool is_streamable() const override {
+			return true;
+		}
+
+		bool affects_results() const override {
+			return false;
+		}
+
+		/**
+		 * @brief Checks if the flag has a file in an existing directory as an argument, and saves it.
+		 *
+		 * @param flag - Flag instance of this specific command
+		 * @param operations - Struct holding operational data
+		 * @return Output(Error) - If Flag doesn't have an argument, or the file's directory doesn't exist
+		 * @return Output(Ok) - If succeeded
+		 */
+		Output validate(const Flag& flag, Instruction& inst, Operations& operations) const override {
+			auto ss = __Helpers::Info::flag_string_stream(flag);
+
+			if (flag.arg.empty()) {
+				ss << "This flag requires an argument!";
+				return Output::new_err(ss.str());
+			}
+
+			std::error_code error;
+			const auto directory = std::filesystem::path(flag.arg).parent_path();
+
+			if (!directory.empty() && !std::filesystem::is_directory(directory, error)) {
+				ss << "Provided file's directory doesn't exists!";
 				return Output::new_err(ss.str());
 			}
 
+			operations.checkpoint = flag.arg;
 			return Output::new_ok("");
 		}
 
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <ostream>
+
+#include "type_aliases.h"
+#include "tokenizer.h"
+#include "parallel.h"
+#include "engine.h"
+
+
+/**
+ * @brief Batch mode running many instructions in one process.
+ * The manifest holds one instruction per line, in the same syntax as the program's arguments,
+ * empty lines and lines starting with '#' are ignored.
+ */
+namespace Batch {
+
+	const String CALLER_VALUE = "-b";
+	const String ALIAS_VALUE = "--batch";
+
+	/**
+	 * @brief Single instruction of the manifest.
+	 */
+	struct Job {
+		usize line;
+		String text;
+		Vec<String> args;
+	};
+
+	/**
+	 * @brief Reads all the jobs from the manifest file.
+	 *
+	 * @param file_name - name of the manifest file
+	 * @return Option<Vec<Job>>(Some) - If the manifest was read
+	 * @return Option<Vec<Job>>(None) - If the manifest file can't be opened
+	 */
+	inline Option<Vec<Job>> read_manifest(const String& file_name) {
+		IFStream file_stream(file_name);
+
+		if (!file_stream.is_open()) {
+			return Option<Vec<Job>>::none();
+		}
+
+		auto jobs = Vec<Job>();
+		String text;
+		usize line = 0;
+
+		while (std::getline(file_stream, text)) {
+			line++;
+
+			auto args = Vec<String>();
+			for (const StringView arg : Tokenizer::split(text)) {
+				args.emplace_back(arg);
+			}
+
+			if (args.empty() || args[0].rfind("#", 0) == 0) {
+				continue;
+			}
+
+			jobs.push_back(Job{ line, text, std::move(args) });
+		}
+
+		return Option<Vec<Job>>::some(jobs);
+	}
+
+	/**
+	 * @brief Executes all the jobs on a pool of workers, all sharing the single Engine.
+	 * Results of every job are written into the stream in the manifest's order, as soon as they are ready,
+	 * jobs with the output file flag write their results only into their own file.
+	 *
+	 * @param jobs - jobs to execute
+	 * @param engine - Engine with all the Commands included
+	 * @param stream - destination of the results
+	 */
+	inline void run(const Vec<Job>& jobs, const Engine& engine, std::ostream& stream) {
+		auto results = Vec<std::optional<String>>(jobs.size());
+		std::mutex mutex;
+		std::condition_variable result_ready;
+		std::atomic<usize> next_job(0);
+
+		const usize workers = std::max<usize>(1, std::min(Parallel::thread_count(), jobs.size()));
+		auto threads = Vec<std::thread>();
+
+		for (usize i = 0; i < workers; i++) {
+			threads.emplace_back([&] {
+				for (usize index = next_job++; index < jobs.size(); index = next_job++) {
+					String result = engine.execute(jobs[index].args);
+
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						results[index] = std::move(result);
+					}
+
+					result_ready.notify_all();
+				}
+			});
+		}
+
+		for (usize index = 0; index < jobs.size(); index++) {
+			String result;
+
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				result_ready.wait(lock, [&results, index] { return results[index].has_value(); });
+
+				result = std::move(*results[index]);
+				results[index].reset();
+			}
+
+			stream << "[JOB " << jobs[index].line << "]: " << jobs[index].text << "\n" << result;
+		}
+
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+
+		stream.flush();
+	}
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cmath>
+
+#include "type_aliases.h"
+#include "tokenizer.h"
+#include "parallel.h"
+#include "hash_table.h"
+
+
+/**
+ * @brief Estimation of the number of the distinct words, in a memory independent of the text's size.
+ */
+namespace Cardinality {
+
+	const u8 MIN_PRECISION = 4;
+	const u8 MAX_PRECISION = 18;
+	const u8 DEFAULT_PRECISION = 14;
+
+	/**
+	 * @brief Size of the windows that the parts of the text are tokenized in.
+	 */
+	const usize WINDOW_SIZE = 1024 * 1024;
+
+	/**
+	 * @brief HyperLogLog sketch of a set of the words.
+	 * It uses 2^precision one byte registers, the standard error of the estimate is about 1.04 / sqrt(2^precision).
+	 * Sketches of the same precision can be merged, the result is the sketch of the union of their sets.
+	 */
+	class HyperLogLog {
+	private:
+		u8 precision;
+		Vec<u8> registers;
+
+	public:
+		/**
+		 * @brief Constructs a new empty HyperLogLog object.
+		 *
+		 * @param precision - number of the hash bits selecting the register, from MIN_PRECISION to MAX_PRECISION
+		 */
+		explicit HyperLogLog(const u8 precision = DEFAULT_PRECISION)
+			: precision(precision), registers((usize)1 << precision, 0) {}
+
+		/**
+		 * @brief Adds the word into the set.
+		 *
+		 * @param word - target word
+		 */
+		void add(const StringView word) {
+			const u64 word_hash = HashTable::hash(word);
+			const usize index = (usize)(word_hash >> (64 - precision));
+			const u64 rest = word_hash << precision;
+
+			// Position of the first set bit in the remaining bits, counted from 1
+			u8 rank = 1;
+			const u8 max_rank = 64 - precision + 1;
+
+			while (rank < max_rank && (rest & (1ull << (64 - rank))) == 0) {
+				rank++;
+			}
+
+			if (registers[index] < rank) {
+				registers[index] = rank;
+			}
+		}
+
+		/**
+		 * @brief Adds all the words of the other sketch into this one.
+		 *
+		 * @param other - sketch of the same precision
+		 */
+		void merge(const HyperLogLog& other) {
+			for (usize i = 0; i < registers.size(); i++) {
+				if (registers[i] < other.registers[i]) {
+					registers[i] = other.registers[i];
+				}
+			}
+		}
+
+		/**
+		 * @brief Estimates the number of the distinct words added into the set.
+		 * Small sets are estimated by the linear counting of the empty registers.
+		 *
+		 * @return estimated number of the distinct words
+		 */
+		usize estimate() const {
+			const f64 size = (f64)registers.size();
+
+			f64 alpha = 0.7213 / (1.0 + 1.079 / size);
+			if (registers.size() == 16) alpha = 0.673;
+			else if (registers.size() == 32) alpha = 0.697;
+			else if (registers.size() == 64) alpha = 0.709;
+
+			f64 sum = 0;
+			usize zeros = 0;
+
+			for (const u8 value : registers) {
+				sum += std::ldexp(1.0, -(i32)value);
+				zeros += value == 0;
+			}
+
+			f64 result = alpha * size * size / sum;
+
+			if (result <= 2.5 * size && zeros != 0) {
+				result = size * std::log(size / (f64)zeros);
+			}
+
+			return (usize)(result + 0.5);
+		}
+	};
+
+	/**
+	 * @brief Sketches all the words of the text, on all the cores for the large texts.
+	 * Every thread sketches it's own part of the text, and the sketches are merged at the end.
+	 *
+	 * @param text - target text
+	 * @param precision - precision of the sketch
+	 * @return HyperLogLog sketch of the text's words
+	 */
+	inline HyperLogLog sketch(const StringView text, const u8 precision) {
+		const auto parts = Parallel::split_at_spaces(text, Parallel::part_count(text.size()));
+		auto sketches = Vec<HyperLogLog>(parts.size(), HyperLogLog(precision));
+
+		Parallel::for_each_index(parts.size(), [&parts, &sketches](const usize index) {
+			Tokenizer::for_each_window(parts[index], WINDOW_SIZE, [&sketches, index](const StringView window) {
+				for (const StringView word : Tokenizer::split(window)) {
+					sketches[index].add(word);
+				}
+			});
+		});
+
+		auto result = HyperLogLog(precision);
+		for (const HyperLogLog& part_sketch : sketches) {
+			result.merge(part_sketch);
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <filesystem>
+#include <ostream>
+
+#include "type_aliases.h"
+#include "hash_table.h"
+#include "statistics.h"
+#include "file_operations.cpp"
+
+
+/**
+ * @brief Checkpoints of the counters of files that only grow (ex: logs).
+ * A checkpoint holds the offset the file was scanned up to and the scanner's state there, including a word cut at the end,
+ * so the next scan reads only the bytes appended since then.
+ * If the file got shorter, or the bytes before the offset changed, it's scanned again from the start.
+ *
+ * Checkpoint file:
+ * <offset> <tail hash> <scanner state> <lines> <digits> <chars> <words> <numbers>
+ * <absolute path of the scanned file>
+ */
+namespace Checkpoint {
+
+	/**
+	 * @brief Number of the bytes before the offset that are compared to check if the file was only appended to.
+	 */
+	const usize TAIL_SIZE = 4096;
+
+	/**
+	 * @brief Position the file was scanned up to, and the scanner's state at it.
+	 */
+	struct State {
+		String source;
+		usize offset = 0;
+		u64 tail_hash = 0;
+		Statistics::Scanner scanner;
+	};
+
+	namespace __State {
+		inline u64 tail_hash(const String& file_name, const usize offset) {
+			const usize start = offset > TAIL_SIZE ? offset - TAIL_SIZE : 0;
+			return HashTable::hash(File::read_range(file_name, start, offset - start));
+		}
+	}
+
+	/**
+	 * @brief Reads the checkpoint.
+	 *
+	 * @param checkpoint_file - name of the checkpoint file
+	 * @return Option<State>(Some) - If the checkpoint was read
+	 * @return Option<State>(None) - If the checkpoint file doesn't exist, or is invalid
+	 */
+	inline Option<State> load(const String& checkpoint_file) {
+		IFStream file_stream(checkpoint_file);
+		State state;
+		Statistics::Counters& counters = state.scanner.counters;
+		u32 scanner_state = 0;
+
+		if (!(file_stream >> state.offset >> state.tail_hash >> scanner_state
+			>> counters.lines >> counters.digits >> counters.chars >> counters.words >> counters.numbers)
+			|| scanner_state > Statistics::__Kernel::Word) {
+			return Option<State>::none();
+		}
+
+		file_stream >> std::ws;
+		if (!std::getline(file_stream, state.source)) {
+			return Option<State>::none();
+		}
+
+		state.scanner.state = (u8)scanner_state;
+		return Option<State>::some(state);
+	}
+
+	/**
+	 * @brief Saves the checkpoint, replacing the previous one at once.
+	 *
+	 * @param checkpoint_file - name of the checkpoint file
+	 * @param state - checkpoint to save
+	 * @return true - If the checkpoint was saved
+	 */
+	inline bool save(const String& checkpoint_file, const State& state) {
+		return File::write_atomically(checkpoint_file, [&state](std::ostream& stream) {
+			const Statistics::Counters& counters = state.scanner.counters;
+
+			stream << state.offset << " " << state.tail_hash << " " << (u32)state.scanner.state << " "
+				<< counters.lines << " " << counters.digits << " " << counters.chars << " " << counters.words << " " << counters.numbers << "\n"
+				<< state.source << "\n";
+		});
+	}
+
+	/**
+	 * @brief Counts everything in the file, resuming from the checkpoint if the file was only appended to since it was saved,
+	 * and saves the new checkpoint at the end of the file.
+	 *
+	 * @param file_name - name of the file to scan
+	 * @param checkpoint_file - name of the checkpoint file
+	 * @return Counters of the whole file
+	 */
+	inline Statistics::Counters scan_file(const String& file_name, const String& checkpoint_file) {
+		std::error_code error;
+
+		State current;
+		current.source = std::filesystem::absolute(file_name, error).string();
+
+		auto saved = load(checkpoint_file);
+		if (saved.is_some()) {
+			const State state = saved.get_value();
+
+			if (state.source == current.source
+				&& state.offset <= File::get_size(file_name)
+				&& state.tail_hash == __State::tail_hash(file_name, state.offset)) {
+				current = state;
+			}
+		}
+
+		File::for_each_chunk_from(file_name, current.offset, File::CHUNK_SIZE, [&current](const char* data, const usize size) {
+			current.scanner.feed(data, size);
+			current.offset += size;
+		});
+
+		current.tail_hash = __State::tail_hash(file_name, current.offset);
+		save(checkpoint_file, current);
+
+		return current.scanner.finish();
+	}
+}
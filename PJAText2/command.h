@@ -9,6 +9,8 @@
  */
 struct Command {
 
+	virtual ~Command() = default;
+
 	/**
 	 * @brief Virtual method for getting the Flag's caller (ex: -f)
 	 *
@@ -40,40 +42,102 @@ struct Command {
 	 * @return Output
 	 */
 	virtual Output execute(const Flag&, Operations&) const = 0;
+
+	/**
+	 * @brief Virtual method for checking if the Command can work in the stream mode,
+	 * where the source is read in chunks and never loaded as a whole.
+	 *
+	 * @return true - If the Command works without the loaded source
+	 * @return false - If the Command requires the loaded source (default)
+	 */
+	virtual bool is_streamable() const {
+		return false;
+	}
+
+	/**
+	 * @brief Virtual method for checking if the Command's execution only reads the Operations,
+	 * so the Engine can execute it concurrently with the other read-only Commands.
+	 *
+	 * @return true - If the execution doesn't modify the Operations
+	 * @return false - If the execution has to run alone (default)
+	 */
+	virtual bool is_read_only() const {
+		return false;
+	}
+
+	/**
+	 * @brief Virtual method for checking if the Command's Flag changes the Outputs,
+	 * so it's a part of the instruction the cached Outputs are keyed by.
+	 *
+	 * @return true - If the Flag changes the Outputs (default)
+	 * @return false - If the Flag only changes how the Outputs are produced, or where they are written
+	 */
+	virtual bool affects_results() const {
+		return true;
+	}
 };
 
 
 /**
  * @brief Class that is a collection of the Commands.
+ * Callers and aliases are indexed in one hash map, so finding the Command of a Flag is a single lookup.
  */
 class CommandsHolder {
 private:
-	HashMap<u32, String> callers;
-	HashMap<u32, String> aliases;
-	HashMap<u32, Command*> commands;
-	u32 id;
+	/**
+	 * @brief Command registered under a name, and if the name is it's caller or alias.
+	 */
+	struct Entry {
+		Command* command;
+		bool is_caller;
+	};
+
+	HashMap<String, Entry> names;
+
+	/**
+	 * @brief Get the Command registered under the name as a caller or as an alias.
+	 */
+	Option<Command*> get_by_kind(const String& name, const bool is_caller) const {
+		const auto found = names.find(name);
+
+		if (found == names.end() || found->second.is_caller != is_caller) {
+			return Option<Command*>::none();
+		}
+
+		return Option<Command*>::some(found->second.command);
+	}
 
 public:
 	CommandsHolder() {
-		callers = HashMap<u32, String>();
-		aliases = HashMap<u32, String>();
-		commands = HashMap<u32, Command*>();
-		id = 0;
+		names = HashMap<String, Entry>();
 	}
 
 	/**
-	 * @brief Adds a pointer of a Command and related Flag's caller and alias.
+	 * @brief Adds a pointer of a Command and indexes it by the related Flag's caller and alias.
+	 * If a name is both a caller and an alias, the caller wins.
 	 *
-	 * @param caller
-	 * @param alias
 	 * @param command_ptr
 	 */
 	void add(Command* command_ptr) {
-		callers[id] = command_ptr->caller();
-		aliases[id] = command_ptr->alias();
-		commands[id] = command_ptr;
+		names[command_ptr->caller()] = Entry{ command_ptr, true };
+		names.emplace(command_ptr->alias(), Entry{ command_ptr, false });
+	}
+
+	/**
+	 * @brief Get the Command by it's caller or alias.
+	 *
+	 * @param name - Name of the Flag
+	 * @return Option<Command*>(Some) - If the command was found
+	 * @return Option<Command*>(None) - If the command was not found
+	 */
+	Option<Command*> get(const String& name) const {
+		const auto found = names.find(name);
+
+		if (found == names.end()) {
+			return Option<Command*>::none();
+		}
 
-		id++;
+		return Option<Command*>::some(found->second.command);
 	}
 
 	/**
@@ -83,14 +147,8 @@ public:
 	 * @return Option<Command*>(Some) - If the command was found
 	 * @return Option<Command*>(None) - If the command was not found
 	 */
-	Option<Command*> get_by_alias(const String& alias) {
-		for (auto& pair : aliases) {
-			if (pair.second == alias) {
-				return Option<Command*>::some(commands[pair.first]);
-			}
-		}
-
-		return Option<Command*>::none();
+	Option<Command*> get_by_alias(const String& alias) const {
+		return get_by_kind(alias, false);
 	}
 
 	/**
@@ -100,14 +158,8 @@ public:
 	 * @return Option<Command*>(Some) - If the command was found
 	 * @return Option<Command*>(None) - If the command was not found
 	 */
-	Option<Command*> get_by_caller(const String& caller) {
-		for (auto& pair : callers) {
-			if (pair.second == caller) {
-				return Option<Command*>::some(commands[pair.first]);
-			}
-		}
-
-		return Option<Command*>::none();
+	Option<Command*> get_by_caller(const String& caller) const {
+		return get_by_kind(caller, true);
 	}
 
 	/**
@@ -118,25 +170,7 @@ public:
 	 * @return true - If Command was found
 	 * @return false - If Command was not found
 	 */
-	bool exists(const String& caller, const String& alias) {
-		bool found_caller = false;
-
-		for (auto& pair : callers) {
-			if (pair.second == caller) {
-				found_caller = true;
-			}
-		}
-
-		if (!found_caller) {
-			return false;
-		}
-
-		for (auto& pair : aliases) {
-			if (pair.second == alias) {
-				return true;
-			}
-		}
-
-		return false;
+	bool exists(const String& caller, const String& alias) const {
+		return get_by_caller(caller).is_some() && get_by_alias(alias).is_some();
 	}
 };
@@ -1,124 +1,245 @@
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+
 #include "type_aliases.h"
 #include "instruction.h"
 #include "command.h"
 #include "file_operations.cpp"
 #include "app_commands.h"
+#include "parallel.h"
+#include "output_sink.h"
+
+
+/**
+ * @brief State of a single execution: the Outputs and the operational data shared by the Commands.
+ * Every execution gets it's own context, so the Engine itself is never modified while executing.
+ */
+struct ExecutionContext {
+	Vec<Output> outputs;
+	Operations operations;
+};
 
 
 /**
  * @brief Core of the project.
- * Modular flag engine holding Flag specific commands, it's outputs, and fumctional structure.
+ * Modular flag engine holding Flag specific commands, and fumctional structure.
  * Each execution is done on vector of Strings which is parsed into the Instruction class and then each Flag's command functionality validated and executed.
+ * Executions don't modify the Engine, so one Engine can execute on many threads at once.
  */
 class Engine {
 private:
 	CommandsHolder commands;
-	Vec<Output> outputs;
-	Operations operations;
+	Vec<std::unique_ptr<Command>> owned_commands;
 
 	/**
-	 * @brief Clears the Engine to prepare it for another execution.
+	 * @brief Gets the validated Commands in the order of their Flags' positions.
+	 *
+	 * @param validated_commands - Commands with their Flags
+	 * @return Vec with the ordered Commands and their Flags
 	 */
-	void clear() {
-		outputs.clear();
-		operations = Operations();
+	static Vec<Pair<Command*, Flag>> ordered_commands(const HashMap<Command*, Flag>& validated_commands) {
+		auto ordered = Vec<Pair<Command*, Flag>>(validated_commands.begin(), validated_commands.end());
+		std::sort(ordered.begin(), ordered.end(), [](const Pair<Command*, Flag>& left, const Pair<Command*, Flag>& right) {
+			return left.second.pos < right.second.pos;
+		});
+
+		return ordered;
 	}
 
 	/**
-	 * @brief Transforms all the Outputs into one String and returns it (or saves into an output file) and then cleans the Engine.
+	 * @brief Writes all the Outputs one by one into the stream.
+	 * Messages with a writer are produced straight into the destination, without building them in the memory.
 	 *
-	 * @return All the Command's Outputs as an one String, or empty value if it has been saved into an output file
+	 * @param outputs - Outputs of the execution
+	 * @param destination - destination stream
 	 */
-	String grab_output() {
-		StringStream output_stream;
-
-		for (Output output : outputs) {
-			String message = output.get_message();
-
-			if (message.empty()) {
+	static void write_messages(const Vec<Output>& outputs, std::ostream& destination) {
+		for (const Output& output : outputs) {
+			if (output.is_empty()) {
 				continue;
 			}
 
-			String result = "";
-			if (output.is_ok()) {
-				result = "[SUCCESS]";
-			}
-			else {
-				result = "[ERROR]";
-			}
+			destination << (output.is_ok() ? "[SUCCESS]" : "[ERROR]") << ": ";
+			output.write_message(destination);
+			destination << "\n";
+		}
+	}
 
-			output_stream << result << ": " << message << "\n";
+	/**
+	 * @brief Passes the destination of the execution's Outputs to the callback: the output file if it was set, or the stream.
+	 *
+	 * @tparam W - Type of the callback taking (std::ostream& destination)
+	 * @param context - current execution
+	 * @param stream - destination stream, used unless the output file was set
+	 * @param write - function writing into the destination
+	 */
+	template <typename W>
+	static void with_destination(const ExecutionContext& context, std::ostream& stream, W write) {
+		if (context.operations.file_out.empty()) {
+			write(stream);
+			stream.flush();
+			return;
 		}
 
-		if (!operations.file_out.empty()) {
-			File::write_unchecked(operations.file_out, output_stream.str());
+		auto file_sink = OutputSink::open_file(context.operations.file_out);
 
-			clear();
-			return "";
+		if (file_sink == nullptr) {
+			stream << "[ERROR]: <ENGINE> Output file can't be opened!\n";
+			return;
 		}
 
-		clear();
-		return output_stream.str();
+		write(file_sink->stream());
+		file_sink->stream().flush();
 	}
 
 	/**
-	 * @brief Adds all the core commands
+	 * @brief Builds the instruction the cached Outputs are keyed by, from the Flags changing the Outputs.
+	 * Every such Flag of the instruction is included in order, with it's argument and the state set by the modifiers,
+	 * so repeated and modified Flags never share an entry with a different instruction.
+	 *
+	 * @param flags - all the Flags of the validated Instruction
+	 * @return normalized instruction
 	 */
-	void add_base_commands() {
-		this->add(BaseCommands::SourceFile())
-			->add(BaseCommands::InputFile())
-			->add(BaseCommands::OutputFile());
-	}
+	String normalized_instruction(const Vec<Flag>& flags) const {
+		StringStream ss;
 
-public:
-	Engine() {
-		commands = CommandsHolder();
-		outputs = Vec<Output>();
-		operations = Operations();
+		for (const Flag& flag : flags) {
+			auto command = commands.get(flag.name).get_value();
 
-		add_base_commands();
+			if (command->affects_results()) {
+				ss << command->caller() << " " << flag.mod << " " << flag.limit << " "
+					<< flag.arg.size() << ":" << flag.arg << "\n";
+			}
+		}
+
+		return ss.str();
 	}
 
 	/**
-	 * @brief Creates a static copy of the provided Command's child and adds it's pointer into the Engine.
-	 * If a specific Command exists or is invalid, it's being ignored.
+	 * @brief Executes the validated Commands in the order of their Flags' positions.
+	 * Consecutive read-only Commands run concurrently on the shared thread pool, the others run alone.
+	 * The Outputs are always added in the order of the Flags' positions.
 	 *
-	 * @tparam C - Type of the Command's child
-	 * @param command_generic - Command's child
-	 * @return Engine pointer
+	 * @param context - current execution
+	 * @param validated_commands - Commands with their Flags
 	 */
-	template <typename C>
-	Engine* add(C command_generic) {
-		static C command = command_generic;
-		Command* command_ptr = (Command*)(&command);
+	void execute_commands(ExecutionContext& context, const HashMap<Command*, Flag>& validated_commands) const {
+		const auto ordered = ordered_commands(validated_commands);
 
-		if (command_ptr == nullptr) {
-			return this;
+		auto results = Vec<Output>(ordered.size());
+		Operations& operations = context.operations;
+		usize index = 0;
+
+		while (index < ordered.size()) {
+			usize end = index;
+			while (end < ordered.size() && ordered[end].first->is_read_only()) {
+				end++;
+			}
+
+			if (end - index < 2 || Parallel::thread_count() < 2) {
+				end = end == index ? index + 1 : end;
+
+				for (usize i = index; i < end; i++) {
+					results[i] = ordered[i].first->execute(ordered[i].second, operations);
+				}
+			}
+			else {
+				auto tasks = Vec<std::function<void()>>();
+
+				for (usize i = index; i < end; i++) {
+					tasks.push_back([&ordered, &results, &operations, i] {
+						results[i] = ordered[i].first->execute(ordered[i].second, operations);
+					});
+				}
+
+				Parallel::shared_pool().run(tasks);
+			}
+
+			index = end;
 		}
 
-		if (commands.exists(
-			command_ptr->caller(),
-			command_ptr->alias()
-		)) {
-			return this;
+		for (Output& output : results) {
+			if (!output.is_empty()) {
+				context.outputs.push_back(output);
+			}
 		}
+	}
 
-		commands.add(command_ptr);
+	/**
+	 * @brief Writes the cached Outputs of the instruction if there are any,
+	 * otherwise executes the Commands and writes their Outputs, storing them in the cache at the same time.
+	 * Outputs with an error, or larger than the cache's size limit, are never stored.
+	 *
+	 * @param context - current execution
+	 * @param validated_commands - Commands with their Flags
+	 * @param validated_flags - all the Flags of the validated Instruction
+	 * @param stream - destination stream, used unless the output file was set
+	 */
+	void execute_cached(ExecutionContext& context, const HashMap<Command*, Flag>& validated_commands, const Vec<Flag>& validated_flags, std::ostream& stream) const {
+		const auto& settings = context.operations.cache;
+		auto source_hash = ResultCache::source_hash(settings, context.operations.file_in);
 
-		return this;
+		if (source_hash.is_none()) {
+			execute_commands(context, validated_commands);
+			with_destination(context, stream, [&context](std::ostream& destination) {
+				write_messages(context.outputs, destination);
+			});
+
+			return;
+		}
+
+		const auto key = ResultCache::entry_key(source_hash.get_value(), normalized_instruction(validated_flags));
+
+		with_destination(context, stream, [this, &context, &validated_commands, &settings, &key](std::ostream& destination) {
+			if (ResultCache::read(settings, key, destination)) {
+				return;
+			}
+
+			execute_commands(context, validated_commands);
+
+			const bool failed = std::any_of(context.outputs.begin(), context.outputs.end(), [](const Output& output) {
+				return output.is_err();
+			});
+
+			if (failed) {
+				write_messages(context.outputs, destination);
+				return;
+			}
+
+			ResultCache::write_through(settings, key, destination, [&context](std::ostream& both) {
+				write_messages(context.outputs, both);
+			});
+		});
+	}
+
+	/**
+	 * @brief Adds all the core commands
+	 */
+	void add_base_commands() {
+		this->add(BaseCommands::StreamMode())
+			->add(BaseCommands::SourceFile())
+			->add(BaseCommands::InputFile())
+			->add(BaseCommands::OutputFile());
 	}
 
 	/**
-	 * @brief Creates an Instruction out of Vec<String>, checks if the Flags are valid, executes the logic behind them and returns their Output.
+	 * @brief Creates an Instruction out of Vec<String>, and checks if the Flags are valid.
 	 *
+	 * @param context - current execution
 	 * @param raw_args - Vector of Strings that holds flags and their arguments
-	 * @return All the Flags outputs as a one String object
+	 * @param validated_commands - filled with the Commands of the Flags
+	 * @param validated_flags - filled with all the Flags of the Instruction, as modified by the validation
+	 * @return true - If all the Flags are valid
+	 * @return false - If the execution panicked, it's Outputs hold the reason
 	 */
-	String execute(const Vec<String>& raw_args) {
+	bool validate(ExecutionContext& context, const Vec<String>& raw_args, HashMap<Command*, Flag>& validated_commands, Vec<Flag>& validated_flags) const {
 		auto inst = Instruction::from_vec_string(raw_args);
-		auto validated_commands = HashMap<Command*, Flag>();
+
+		Vec<Output>& outputs = context.outputs;
+		Operations& operations = context.operations;
 
 		if (inst.flag_exists(
 			BaseCommands::InputFile::CALLER_VALUE,
@@ -129,7 +250,7 @@ public:
 					Output::new_err("<ENGINE> Input file flag should be the only one!")
 				);
 
-				return grab_output();
+				return false;
 			}
 
 			auto flag_ptr = inst.get_flag_ptr(0);
@@ -138,7 +259,7 @@ public:
 					Output::new_err("<ENGINE> Input file flag requires an argument!")
 				);
 
-				return grab_output();
+				return false;
 			}
 
 			if (!File::exists(flag_ptr->arg)) {
@@ -146,7 +267,7 @@ public:
 					Output::new_err("<ENGINE> Input file flag has invalid file as an argument!")
 				);
 
-				return grab_output();
+				return false;
 			}
 
 			inst = Instruction::from_vec_string(
@@ -157,11 +278,7 @@ public:
 		}
 
 		for (Flag flag : inst.get_flags()) {
-			Option<Command*> command_o = commands.get_by_caller(flag.name);
-
-			if (command_o.is_none()) {
-				command_o = commands.get_by_alias(flag.name);
-			}
+			Option<Command*> command_o = commands.get(flag.name);
 
 			if (command_o.is_some()) {
 				auto command = command_o.get_value();
@@ -189,6 +306,19 @@ public:
 			}
 		}
 
+		if (operations.is_streaming && !operations.is_panicked) {
+			for (auto& pair : validated_commands) {
+				if (!pair.first->is_streamable()) {
+					outputs.push_back(
+						Output::new_err("<ENGINE> Flag [" + pair.second.name + "] can't be used in the stream mode!")
+					);
+
+					operations.is_panicked = true;
+					break;
+				}
+			}
+		}
+
 		if (operations.file_in.empty() && operations.source.empty()) {
 			outputs.push_back(
 				Output::new_err("<ENGINE> Source file is invalid!")
@@ -198,17 +328,80 @@ public:
 		}
 
 		if (operations.is_panicked) {
-			return grab_output();
+			return false;
 		}
 
-		for (auto& pair : validated_commands) {
-			auto output = pair.first->execute(pair.second, operations);
+		validated_flags = inst.get_flags();
+		return true;
+	}
 
-			if (!output.get_message().empty()) {
-				outputs.push_back(output);
-			}
+public:
+	Engine() {
+		commands = CommandsHolder();
+
+		add_base_commands();
+	}
+
+	/**
+	 * @brief Creates a copy of the provided Command's child owned by this Engine and adds it's pointer into the Engine.
+	 * If a specific Command exists, it's being ignored.
+	 *
+	 * @tparam C - Type of the Command's child
+	 * @param command_generic - Command's child
+	 * @return Engine pointer
+	 */
+	template <typename C>
+	Engine* add(C command_generic) {
+		if (commands.exists(
+			command_generic.caller(),
+			command_generic.alias()
+		)) {
+			return this;
+		}
+
+		owned_commands.push_back(std::make_unique<C>(command_generic));
+		commands.add(owned_commands.back().get());
+
+		return this;
+	}
+
+	/**
+	 * @brief Executes the Flags from Vec<String> and writes their Outputs straight into the stream (or into an output file).
+	 * Safe to call from many threads at once.
+	 *
+	 * @param raw_args - Vector of Strings that holds flags and their arguments
+	 * @param stream - destination of the Outputs
+	 */
+	void execute(const Vec<String>& raw_args, std::ostream& stream) const {
+		ExecutionContext context;
+		auto validated_commands = HashMap<Command*, Flag>();
+		auto validated_flags = Vec<Flag>();
+
+		if (validate(context, raw_args, validated_commands, validated_flags) && !context.operations.cache.directory.empty()) {
+			execute_cached(context, validated_commands, validated_flags, stream);
+			return;
+		}
+
+		if (!context.operations.is_panicked) {
+			execute_commands(context, validated_commands);
 		}
 
-		return grab_output();
+		with_destination(context, stream, [&context](std::ostream& destination) {
+			write_messages(context.outputs, destination);
+		});
+	}
+
+	/**
+	 * @brief Executes the Flags from Vec<String> and returns their Output.
+	 * Safe to call from many threads at once.
+	 *
+	 * @param raw_args - Vector of Strings that holds flags and their arguments
+	 * @return All the Flags outputs as a one String object, or empty value if it has been saved into an output file
+	 */
+	String execute(const Vec<String>& raw_args) const {
+		StringStream output_stream;
+		execute(raw_args, output_stream);
+
+		return output_stream.str();
 	}
 };
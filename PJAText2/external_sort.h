@@ -0,0 +1,356 @@
+#pragma once
+
+#include <algorithm>
+#include <filesystem>
+#include <queue>
+#include <random>
+
+#include "type_aliases.h"
+#include "tokenizer.h"
+#include "sorting.h"
+
+
+/**
+ * @brief External merge sort of the words, for the listings that don't fit into the memory.
+ * The words are sorted in runs bounded by the memory limit, each run is spilled into a temporary file,
+ * and the files are k-way merged into the output, in passes if there are more than MAX_FAN_IN of them.
+ */
+namespace ExternalSort {
+
+	/**
+	 * @brief Approximate memory needed by a single word in a run: the view, the sorting buffer and the radix key.
+	 */
+	const usize BYTES_PER_WORD = sizeof(StringView) * 2 + sizeof(u16);
+
+	/**
+	 * @brief Size of the source windows that are tokenized at once.
+	 */
+	const usize WINDOW_SIZE = 1024 * 1024;
+
+	/**
+	 * @brief Maximum number of the runs merged at once, so the number of the open files stays bounded.
+	 */
+	const usize MAX_FAN_IN = 32;
+
+	/**
+	 * @brief Options of the sort.
+	 */
+	struct Settings {
+		usize memory_limit;
+		String temp_dir;
+		bool by_length;
+		bool descending;
+		usize top = 0;
+	};
+
+	namespace __Runs {
+		/**
+		 * @brief Temporary file holding one sorted run, one word per line.
+		 * The file is removed together with the object.
+		 */
+		struct RunFile {
+			String path;
+
+			explicit RunFile(const String& path) : path(path) {}
+
+			RunFile(const RunFile&) = delete;
+			RunFile& operator=(const RunFile&) = delete;
+
+			~RunFile() {
+				std::error_code error;
+				std::filesystem::remove(path, error);
+			}
+		};
+
+		/**
+		 * @brief Gets the directory for the temporary files.
+		 *
+		 * @param temp_dir - configured directory, or empty for the system default
+		 * @return path of the directory
+		 */
+		inline String directory(const String& temp_dir) {
+			if (!temp_dir.empty()) {
+				return temp_dir;
+			}
+
+			std::error_code error;
+			auto path = std::filesystem::temp_directory_path(error);
+
+			return error ? String(".") : path.string();
+		}
+
+		/**
+		 * @brief Writes the sorted run into a new temporary file.
+		 *
+		 * @param run - sorted words
+		 * @param directory - directory for the file
+		 * @param prefix - unique prefix of the sort's files
+		 * @param runs - collection to add the created file into
+		 * @return true - if the run was written
+		 * @return false - if the file couldn't be written
+		 */
+		inline bool spill(const Tokenizer::Tokens& run, const String& directory, const String& prefix, Vec<std::unique_ptr<RunFile>>& runs) {
+			auto path = (std::filesystem::path(directory) / (prefix + std::to_string(runs.size()) + ".run")).string();
+			runs.push_back(std::make_unique<RunFile>(path));
+
+			OFStream file_stream(path, std::ios::binary | std::ios::trunc);
+
+			for (const StringView word : run) {
+				file_stream.write(word.data(), word.size());
+				file_stream.put('\n');
+			}
+
+			file_stream.close();
+			return !file_stream.fail();
+		}
+
+		/**
+		 * @brief Opens the run files for reading.
+		 *
+		 * @param runs - run files to open
+		 * @param first - index of the first run to open
+		 * @param last - index after the last run to open
+		 * @param readers - filled with the opened files, in the runs' order
+		 * @return true - if all the files were opened
+		 * @return false - if a file couldn't be opened
+		 */
+		inline bool open(const Vec<std::unique_ptr<RunFile>>& runs, const usize first, const usize last, Vec<IFStream>& readers) {
+			readers.clear();
+			readers.reserve(last - first);
+
+			for (usize i = first; i < last; i++) {
+				readers.emplace_back(runs[i]->path, std::ios::binary);
+
+				if (!readers.back().is_open()) {
+					readers.clear();
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		 * @brief Current word of a run during the merge.
+		 */
+		struct Head {
+			String word;
+			usize run;
+		};
+	}
+
+	/**
+	 * @brief Sorted runs of the words, ready to be merged into the output.
+	 * The runs are either spilled into the temporary files, or kept in the memory if all the words fit into one run.
+	 */
+	class SortedRuns {
+	private:
+		Settings settings;
+		Vec<std::unique_ptr<__Runs::RunFile>> files;
+		Tokenizer::Tokens memory_run;
+
+		/**
+		 * @brief Sorts a single run, keeping only it's top words if the listing is limited.
+		 * Words dropped from a run can never be in the top of the whole listing.
+		 *
+		 * @param run - words of the run
+		 */
+		void sort_run(Tokenizer::Tokens& run) const {
+			if (settings.top != 0) {
+				Sorting::top_words(run, settings.top, settings.by_length, settings.descending);
+			}
+			else {
+				Sorting::sort_words(run, settings.by_length, settings.descending);
+			}
+		}
+
+		/**
+		 * @brief Passes the words of the opened runs in the sorted order to the callback, stopping after the top words if the listing is limited.
+		 * Ties are broken by the run index, the runs are in the source order, so the merge is stable.
+		 *
+		 * @tparam W - Type of the callback taking (StringView word)
+		 * @param readers - opened runs, in the source order
+		 * @param write_word - function called with every word in the sorted order
+		 * @return true - if all the runs were read
+		 * @return false - if reading a run failed
+		 */
+		template <typename W>
+		bool merge_readers(Vec<IFStream>& readers, W write_word) const {
+			const Settings& options = settings;
+			const auto after = [&options](const __Runs::Head& left, const __Runs::Head& right) {
+				if (options.by_length && left.word.size() != right.word.size()) {
+					return options.descending ? left.word.size() < right.word.size() : left.word.size() > right.word.size();
+				}
+
+				if (!options.by_length && left.word != right.word) {
+					return options.descending ? left.word < right.word : left.word > right.word;
+				}
+
+				return left.run > right.run;
+			};
+
+			auto heads = std::priority_queue<__Runs::Head, Vec<__Runs::Head>, decltype(after)>(after);
+
+			for (usize i = 0; i < readers.size(); i++) {
+				auto head = __Runs::Head{ String(), i };
+				if (std::getline(readers[i], head.word)) {
+					heads.push(std::move(head));
+				}
+			}
+
+			usize remaining = settings.top != 0 ? settings.top : SIZE_MAX;
+
+			while (!heads.empty() && remaining-- > 0) {
+				auto head = heads.top();
+				heads.pop();
+
+				write_word(StringView(head.word));
+
+				if (std::getline(readers[head.run], head.word)) {
+					heads.push(std::move(head));
+				}
+			}
+
+			return std::none_of(readers.begin(), readers.end(), [](const IFStream& reader) {
+				return reader.bad();
+			});
+		}
+
+		/**
+		 * @brief Merges groups of MAX_FAN_IN runs into the new runs, until there are at most MAX_FAN_IN of them.
+		 *
+		 * @param directory - directory for the files
+		 * @param prefix - unique prefix of the sort's files
+		 * @return true - if the runs were merged
+		 * @return false - if a file couldn't be read or written
+		 */
+		bool reduce(const String& directory, const String& prefix) {
+			for (usize pass = 0; files.size() > MAX_FAN_IN; pass++) {
+				auto merged = Vec<std::unique_ptr<__Runs::RunFile>>();
+				auto readers = Vec<IFStream>();
+
+				for (usize first = 0; first < files.size(); first += MAX_FAN_IN) {
+					const usize last = std::min(first + MAX_FAN_IN, files.size());
+
+					if (!__Runs::open(files, first, last, readers)) {
+						return false;
+					}
+
+					auto path = (std::filesystem::path(directory) / (prefix + "pass" + std::to_string(pass) + "-" + std::to_string(merged.size()) + ".run")).string();
+					merged.push_back(std::make_unique<__Runs::RunFile>(path));
+
+					OFStream file_stream(path, std::ios::binary | std::ios::trunc);
+
+					const bool read = merge_readers(readers, [&file_stream](const StringView word) {
+						file_stream.write(word.data(), word.size());
+						file_stream.put('\n');
+					});
+
+					file_stream.close();
+					if (!read || file_stream.fail()) {
+						return false;
+					}
+				}
+
+				files = std::move(merged);
+			}
+
+			return true;
+		}
+
+	public:
+		explicit SortedRuns(const Settings& settings) : settings(settings) {}
+
+		/**
+		 * @brief Sorts the words of the text into the runs bounded by the memory limit.
+		 *
+		 * @param text - text with the words, has to stay alive until the runs are merged
+		 * @param settings - options of the sort
+		 * @return Shared pointer to the SortedRuns, nullptr if a temporary file couldn't be written or read
+		 */
+		static std::shared_ptr<SortedRuns> sort(const StringView text, const Settings& settings) {
+			const usize max_run = std::max<usize>(1, settings.memory_limit / BYTES_PER_WORD);
+			const String directory = __Runs::directory(settings.temp_dir);
+			const String prefix = "pjatext2-" + std::to_string(std::random_device()()) + "-";
+
+			auto runs = std::make_shared<SortedRuns>(settings);
+			auto& run = runs->memory_run;
+			bool written = true;
+
+			Tokenizer::for_each_window(text, WINDOW_SIZE, [&](const StringView window) {
+				if (!written) {
+					return;
+				}
+
+				for (const StringView word : Tokenizer::split(window)) {
+					run.push_back(word);
+
+					if (run.size() >= max_run) {
+						runs->sort_run(run);
+						written = __Runs::spill(run, directory, prefix, runs->files);
+						run.clear();
+
+						if (!written) {
+							return;
+						}
+					}
+				}
+			});
+
+			if (!written) {
+				return nullptr;
+			}
+
+			runs->sort_run(run);
+
+			if (!runs->files.empty()) {
+				if (!run.empty() && !__Runs::spill(run, directory, prefix, runs->files)) {
+					return nullptr;
+				}
+
+				run = Tokenizer::Tokens();
+			}
+
+			if (!runs->reduce(directory, prefix)) {
+				return nullptr;
+			}
+
+			return runs;
+		}
+
+		/**
+		 * @brief Opens the spilled runs for the merge, so a run that can't be opened is reported before anything is written.
+		 *
+		 * @param readers - filled with the opened runs
+		 * @return true - if all the runs were opened, or there are none
+		 * @return false - if a run couldn't be opened
+		 */
+		bool open(Vec<IFStream>& readers) const {
+			return __Runs::open(files, 0, files.size(), readers);
+		}
+
+		/**
+		 * @brief Passes all the words in the sorted order to the callback, k-way merging the opened runs.
+		 * Words of the same length keep their order from the source when sorting by length.
+		 * The merge stops after the top words if the listing is limited.
+		 *
+		 * @tparam W - Type of the callback taking (StringView word)
+		 * @param readers - runs opened by SortedRuns::open
+		 * @param write_word - function called with every word in the sorted order
+		 * @return true - if all the runs were read
+		 * @return false - if reading a run failed
+		 */
+		template <typename W>
+		bool merge(Vec<IFStream>& readers, W write_word) const {
+			if (files.empty()) {
+				for (const StringView word : memory_run) {
+					write_word(word);
+				}
+
+				return true;
+			}
+
+			return merge_readers(readers, write_word);
+		}
+	};
+}
@@ -1,8 +1,25 @@
+#pragma once
+
 #include "type_aliases.h"
+#include <filesystem>
 #include <iostream>
+#include <memory>
+#include <random>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 
 namespace File {
+	/**
+	 * @brief Default size of the chunks in which the files are streamed.
+	 */
+	const usize CHUNK_SIZE = 4 * 1024 * 1024;
+
 	/**
 	 * @brief Checks if a specific file exists.
 	 *
@@ -36,6 +53,106 @@ namespace File {
 		return content;
 	}
 
+	/**
+	 * @brief Reads the specific file in binary chunks from the offset to the end, without checking for any errors.
+	 * Only one chunk is held in the memory at a time.
+	 *
+	 * @tparam F - Type of the callback taking (const char* data, usize size)
+	 * @param file_name - name of the file to read
+	 * @param offset - position of the first byte to read
+	 * @param chunk_size - maximum size of a single chunk
+	 * @param callback - function called with every chunk, in order
+	 */
+	template <typename F>
+	inline void for_each_chunk_from(const String& file_name, const usize offset, const usize chunk_size, F callback) {
+		IFStream file_stream(file_name, std::ios::binary);
+		auto buffer = Vec<char>(chunk_size);
+
+		if (offset != 0) {
+			file_stream.seekg((std::streamoff)offset);
+		}
+
+		while (file_stream) {
+			file_stream.read(buffer.data(), buffer.size());
+			const usize size = (usize)file_stream.gcount();
+
+			if (size == 0) {
+				break;
+			}
+
+			callback(buffer.data(), size);
+		}
+
+		file_stream.close();
+	}
+
+	/**
+	 * @brief Reads the specific file in binary chunks, without checking for any errors.
+	 * Only one chunk is held in the memory at a time.
+	 *
+	 * @tparam F - Type of the callback taking (const char* data, usize size)
+	 * @param file_name - name of the file to read
+	 * @param chunk_size - maximum size of a single chunk
+	 * @param callback - function called with every chunk, in order
+	 */
+	template <typename F>
+	inline void for_each_chunk(const String& file_name, const usize chunk_size, F callback) {
+		for_each_chunk_from(file_name, 0, chunk_size, callback);
+	}
+
+	/**
+	 * @brief Reads a part of the specific file as is, without checking for any errors.
+	 *
+	 * @param file_name - name of the file to read
+	 * @param offset - position of the first byte to read
+	 * @param size - number of the bytes to read
+	 * @return Read bytes, fewer if the file ends sooner
+	 */
+	inline String read_range(const String& file_name, const usize offset, const usize size) {
+		IFStream file_stream(file_name, std::ios::binary);
+		auto content = String(size, '\0');
+
+		file_stream.seekg((std::streamoff)offset);
+		file_stream.read(&content[0], (std::streamsize)size);
+		content.resize((usize)file_stream.gcount());
+
+		file_stream.close();
+		return content;
+	}
+
+	/**
+	 * @brief Writes the file under a temporary name and renames it, so the concurrent readers never see a part of it.
+	 *
+	 * @tparam W - Type of the callback taking (std::ostream& stream)
+	 * @param target - path of the file to write
+	 * @param write - function writing the content into the stream
+	 * @return true - If the file was written
+	 * @return false - If the file couldn't be written
+	 */
+	template <typename W>
+	inline bool write_atomically(const std::filesystem::path& target, W write) {
+		auto temporary = target;
+		temporary += ".tmp-" + std::to_string(std::random_device()());
+
+		OFStream file_stream(temporary, std::ios::binary | std::ios::trunc);
+		write(file_stream);
+		file_stream.close();
+
+		std::error_code error;
+		if (file_stream.fail()) {
+			std::filesystem::remove(temporary, error);
+			return false;
+		}
+
+		std::filesystem::rename(temporary, target, error);
+		if (error) {
+			std::filesystem::remove(temporary, error);
+			return false;
+		}
+
+		return true;
+	}
+
 	/**
 	 * @brief Overwrites everything in the specific file
 	 *
@@ -63,4 +180,95 @@ namespace File {
 		file_stream.close();
 		return size;
 	}
+
+	/**
+	 * @brief Read-only content of a file.
+	 * On Linux the file is memory mapped and exposed as is,
+	 * elsewhere it's read by File::read_unchecked (with the "\n" appended after every line).
+	 */
+	class Content {
+	private:
+		String buffer;
+		const char* data = nullptr;
+		usize size = 0;
+		bool mapped = false;
+
+		Content() = default;
+
+	public:
+		Content(const Content&) = delete;
+		Content& operator=(const Content&) = delete;
+
+		~Content() {
+#ifdef __linux__
+			if (mapped && size != 0) {
+				munmap((void*)data, size);
+			}
+#endif
+		}
+
+		/**
+		 * @brief Loads the specific file, without checking for any errors.
+		 * Falls back to File::read_unchecked if the file can't be mapped, or isn't a non-empty regular file.
+		 *
+		 * @param file_name - name of the file to load
+		 * @return Shared pointer to the loaded Content
+		 */
+		static std::shared_ptr<const Content> load_unchecked(const String& file_name) {
+			auto content = std::shared_ptr<Content>(new Content());
+
+#ifdef __linux__
+			struct stat info;
+
+			// Only non-empty regular files are mapped, pipes and /proc-like files report no size and have to be read
+			if (stat(file_name.c_str(), &info) == 0 && S_ISREG(info.st_mode) && info.st_size != 0) {
+				int fd = open(file_name.c_str(), O_RDONLY);
+
+				if (fd != -1) {
+					if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size != 0) {
+						void* address = mmap(nullptr, (usize)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+						if (address != MAP_FAILED) {
+							madvise(address, (usize)info.st_size, MADV_SEQUENTIAL);
+							content->data = (const char*)address;
+							content->size = (usize)info.st_size;
+							content->mapped = true;
+						}
+					}
+
+					close(fd);
+				}
+			}
+
+			if (content->mapped) {
+				return content;
+			}
+#endif
+
+			content->buffer = read_unchecked(file_name);
+			content->data = content->buffer.data();
+			content->size = content->buffer.size();
+
+			return content;
+		}
+
+		/**
+		 * @brief Gets the loaded bytes.
+		 *
+		 * @return View of the file's content
+		 */
+		StringView view() const {
+			return StringView(data, size);
+		}
+
+		/**
+		 * @brief Checks if the content is mapped, so it misses the "\n" that File::read_unchecked appends at the end.
+		 *
+		 * @return true - If the content is mapped
+		 * @return false - If the content was read line by line
+		 */
+		bool is_mapped() const {
+			return mapped;
+		}
+	};
 }
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>
+
+#include "type_aliases.h"
+#include "tokenizer.h"
+#include "parallel.h"
+#include "hash_table.h"
+
+
+/**
+ * @brief Word frequency histogram of the source.
+ */
+namespace Frequency {
+
+	/**
+	 * @brief Word with the number of it's occurrences.
+	 */
+	using Entry = Pair<StringView, usize>;
+
+	/**
+	 * @brief Minimal number of the words worth a separate counting thread.
+	 */
+	const usize MIN_PARALLEL_WORDS = 256 * 1024;
+
+	/**
+	 * @brief Counts the occurrences of every word, on all the cores if there is enough of them.
+	 * Every thread counts it's own range of the words into a separate table, and the tables are merged at the end.
+	 *
+	 * @param words - words of the source
+	 * @return WordCounter with all the words
+	 */
+	inline HashTable::WordCounter count(const Tokenizer::Tokens& words) {
+		const usize parts = std::max<usize>(1, std::min(Parallel::thread_count(), words.size() / MIN_PARALLEL_WORDS));
+		auto counters = Vec<HashTable::WordCounter>(parts);
+
+		Parallel::for_each_index(parts, [&words, &counters, parts](const usize index) {
+			const usize begin = words.size() / parts * index;
+			const usize end = index + 1 == parts ? words.size() : words.size() / parts * (index + 1);
+
+			for (usize i = begin; i < end; i++) {
+				counters[index].add(words[i]);
+			}
+		});
+
+		for (usize i = 1; i < parts; i++) {
+			counters[0].merge(counters[i]);
+		}
+
+		return std::move(counters[0]);
+	}
+
+	/**
+	 * @brief Gets the words ordered by the number of their occurrences (the most frequent first), and then alphabetically.
+	 * With the limit set, only the top words are selected and sorted.
+	 *
+	 * @param counter - counted words
+	 * @param limit - number of the words to get, 0 for all of them
+	 * @return Vec<Entry> with the ordered words
+	 */
+	inline Vec<Entry> ranked(const HashTable::WordCounter& counter, const usize limit) {
+		auto entries = Vec<Entry>();
+		entries.reserve(counter.size());
+
+		counter.for_each([&entries](const StringView word, const usize count) {
+			entries.emplace_back(word, count);
+		});
+
+		const auto compare = [](const Entry& left, const Entry& right) {
+			if (left.second != right.second) {
+				return left.second > right.second;
+			}
+
+			return left.first < right.first;
+		};
+
+		if (limit != 0 && limit < entries.size()) {
+			std::nth_element(entries.begin(), entries.begin() + (limit - 1), entries.end(), compare);
+			entries.resize(limit);
+		}
+
+		std::sort(entries.begin(), entries.end(), compare);
+		return entries;
+	}
+}
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <cstring>
+
+#include "type_aliases.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PJA_HASH_TABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+/**
+ * @brief Open addressing hash tables keyed by the views into the source.
+ */
+namespace HashTable {
+
+	/**
+	 * @brief Hashes the bytes of the text, 8 bytes at a time.
+	 *
+	 * @param text - target text
+	 * @return 64 bit hash
+	 */
+	inline u64 hash(const StringView text) {
+		const u64 multiplier = 0x9E3779B97F4A7C15ull;
+		u64 result = multiplier ^ text.size();
+		usize i = 0;
+
+		for (; i + 8 <= text.size(); i += 8) {
+			u64 block;
+			std::memcpy(&block, text.data() + i, 8);
+
+			result = (result ^ block) * multiplier;
+			result = (result << 31) | (result >> 33);
+		}
+
+		if (i < text.size()) {
+			u64 block = 0;
+			std::memcpy(&block, text.data() + i, text.size() - i);
+
+			result = (result ^ block) * multiplier;
+		}
+
+		result ^= result >> 32;
+		result *= 0xD6E8FEB86659FD93ull;
+		result ^= result >> 32;
+
+		return result;
+	}
+
+	namespace __Group {
+		/**
+		 * @brief Number of the control bytes probed at once.
+		 */
+		const usize SIZE = 16;
+
+		/**
+		 * @brief Gets the bitmask of the control bytes in the group equal to the value.
+		 *
+		 * @param group - first control byte of the group
+		 * @param value - control byte to find
+		 * @return bitmask with the bit i set if the byte i matches
+		 */
+		inline u32 match(const u8* group, const u8 value) {
+#ifdef PJA_HASH_TABLE_SSE2
+			const __m128i controls = _mm_loadu_si128((const __m128i*)group);
+			return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8((char)value)));
+#else
+			u32 mask = 0;
+			for (usize i = 0; i < SIZE; i++) {
+				mask |= (u32)(group[i] == value) << i;
+			}
+
+			return mask;
+#endif
+		}
+
+		/**
+		 * @brief Gets the index of the lowest set bit.
+		 *
+		 * @param mask - non zero bitmask of a group
+		 * @return index of the lowest set bit
+		 */
+		inline usize lowest_bit(const u32 mask) {
+#if defined(__GNUC__) || defined(__clang__)
+			return (usize)__builtin_ctz(mask);
+#elif defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward(&index, (unsigned long)mask);
+			return index;
+#else
+			usize index = 0;
+			while (!((mask >> index) & 1)) {
+				index++;
+			}
+			return index;
+#endif
+		}
+	}
+
+	/**
+	 * @brief Swiss table counter of the words.
+	 * Every slot has a control byte holding 7 bits of the word's hash. The control bytes are probed in groups of 16
+	 * with a single SSE2 compare, and the words are touched only on a probable match.
+	 * Groups are probed in the triangular order, which visits all of them for a power of 2 group count.
+	 * The slots are one flat array, without any node allocations.
+	 * The words are views, so they have to stay alive as long as the counter.
+	 */
+	class WordCounter {
+	private:
+		static constexpr u8 EMPTY = 0x80;
+		static constexpr usize MIN_CAPACITY = 1024;
+
+		struct Slot {
+			StringView word;
+			usize count;
+		};
+
+		Vec<u8> controls;
+		Vec<Slot> slots;
+		usize used = 0;
+
+		/**
+		 * @brief Resizes the table to the capacity and moves all the words into it.
+		 *
+		 * @param capacity - new capacity, power of 2
+		 */
+		void rehash(const usize capacity) {
+			auto old_controls = std::move(controls);
+			auto old_slots = std::move(slots);
+
+			controls = Vec<u8>(capacity, EMPTY);
+			slots = Vec<Slot>(capacity);
+
+			for (usize i = 0; i < old_controls.size(); i++) {
+				if (old_controls[i] != EMPTY) {
+					place(old_slots[i].word, hash(old_slots[i].word), old_slots[i].count);
+				}
+			}
+		}
+
+		/**
+		 * @brief Puts a word that isn't in the table yet into the first free slot of it's probe sequence.
+		 */
+		void place(const StringView word, const u64 word_hash, const usize count) {
+			const usize group_mask = controls.size() / __Group::SIZE - 1;
+			usize group = (usize)(word_hash >> 7) & group_mask;
+
+			for (usize step = 1; ; step++) {
+				const usize first = group * __Group::SIZE;
+				const u32 empty = __Group::match(&controls[first], EMPTY);
+
+				if (empty != 0) {
+					const usize index = first + __Group::lowest_bit(empty);
+
+					controls[index] = (u8)(word_hash & 0x7F);
+					slots[index] = Slot{ word, count };
+					return;
+				}
+
+				group = (group + step) & group_mask;
+			}
+		}
+
+	public:
+		/**
+		 * @brief Constructs a new WordCounter object.
+		 *
+		 * @param expected - expected number of the distinct words, to avoid the rehashing
+		 */
+		explicit WordCounter(const usize expected = 0) {
+			usize capacity = MIN_CAPACITY;
+			while (capacity / 8 * 7 < expected) {
+				capacity *= 2;
+			}
+
+			controls = Vec<u8>(capacity, EMPTY);
+			slots = Vec<Slot>(capacity);
+		}
+
+		/**
+		 * @brief Adds the occurrences of the word.
+		 *
+		 * @param word - target word
+		 * @param count - number of the occurrences
+		 */
+		void add(const StringView word, const usize count = 1) {
+			const u64 word_hash = hash(word);
+			const u8 control = (u8)(word_hash & 0x7F);
+			const usize group_mask = controls.size() / __Group::SIZE - 1;
+			usize group = (usize)(word_hash >> 7) & group_mask;
+
+			for (usize step = 1; ; step++) {
+				const usize first = group * __Group::SIZE;
+
+				for (u32 matches = __Group::match(&controls[first], control); matches != 0; matches &= matches - 1) {
+					Slot& slot = slots[first + __Group::lowest_bit(matches)];
+
+					if (slot.word == word) {
+						slot.count += count;
+						return;
+					}
+				}
+
+				// Nothing is ever removed, so a group with a free slot ends the probe sequence
+				if (__Group::match(&controls[first], EMPTY) != 0) {
+					break;
+				}
+
+				group = (group + step) & group_mask;
+			}
+
+			// Group probing keeps the probe sequences short up to the load factor of 7/8
+			if ((used + 1) * 8 > controls.size() * 7) {
+				rehash(controls.size() * 2);
+			}
+
+			place(word, word_hash, count);
+			used++;
+		}
+		/**
+		 * @brief Adds all the words with their counts from the other counter.
+		 *
+		 * @param other - counter to merge
+		 */
+		void merge(const WordCounter& other) {
+			other.for_each([this](const StringView word, const usize count) {
+				add(word, count);
+			});
+		}
+
+		/**
+		 * @brief Calls the callback for every word in the table, in no particular order.
+		 *
+		 * @tparam F - Type of the callback taking (StringView word, usize count)
+		 * @param callback - function to call
+		 */
+		template <typename F>
+		void for_each(F callback) const {
+			for (usize i = 0; i < controls.size(); i++) {
+				if (controls[i] != EMPTY) {
+					callback(slots[i].word, slots[i].count);
+				}
+			}
+		}
+
+		/**
+		 * @brief Gets the number of the distinct words.
+		 *
+		 * @return number of the words
+		 */
+		usize size() const {
+			return used;
+		}
+	};
+}
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+
+#include "type_aliases.h"
+#include "hash_table.h"
+
+
+/**
+ * @brief Approximate frequencies of the words in a bounded memory, for the sources too large for a full table.
+ */
+namespace HeavyHitters {
+
+	/**
+	 * @brief Number of the words monitored for every wanted heavy hitter.
+	 */
+	const usize CAPACITY_FACTOR = 8;
+
+	/**
+	 * @brief Word with it's estimated count, the real count is between count - error and count.
+	 */
+	struct Entry {
+		String word;
+		usize count;
+		usize error;
+	};
+
+	/**
+	 * @brief Space-Saving summary of the most frequent words.
+	 * It monitors at most "capacity" words, a new word replaces the least frequent one and inherits it's count as the error.
+	 * Every word occurring more than total / capacity times is guaranteed to be monitored.
+	 */
+	class SpaceSaving {
+	private:
+		usize capacity;
+		usize used = 0;
+
+		// Slots never move, so the map's views into the words stay valid
+		Vec<String> words;
+		Vec<usize> counts;
+		Vec<usize> errors;
+		HashMap<StringView, usize> slots;
+
+		// Min-heap of the slots ordered by the count, and the position of every slot in it
+		Vec<usize> heap;
+		Vec<usize> positions;
+
+		void swap_nodes(const usize left, const usize right) {
+			std::swap(heap[left], heap[right]);
+			positions[heap[left]] = left;
+			positions[heap[right]] = right;
+		}
+
+		/**
+		 * @brief Moves the node down the heap after it's count was increased.
+		 */
+		void sift_down(usize node) {
+			while (true) {
+				const usize left = node * 2 + 1;
+				const usize right = left + 1;
+				usize smallest = node;
+
+				if (left < used && counts[heap[left]] < counts[heap[smallest]]) smallest = left;
+				if (right < used && counts[heap[right]] < counts[heap[smallest]]) smallest = right;
+
+				if (smallest == node) {
+					return;
+				}
+
+				swap_nodes(node, smallest);
+				node = smallest;
+			}
+		}
+
+		/**
+		 * @brief Moves the new node up the heap.
+		 */
+		void sift_up(usize node) {
+			while (node != 0) {
+				const usize parent = (node - 1) / 2;
+
+				if (counts[heap[parent]] <= counts[heap[node]]) {
+					return;
+				}
+
+				swap_nodes(node, parent);
+				node = parent;
+			}
+		}
+
+	public:
+		/**
+		 * @brief Constructs a new SpaceSaving object.
+		 *
+		 * @param capacity - maximal number of the monitored words, at least 1
+		 */
+		explicit SpaceSaving(const usize capacity)
+			: capacity(std::max<usize>(1, capacity)),
+			words(this->capacity), counts(this->capacity), errors(this->capacity),
+			heap(this->capacity), positions(this->capacity) {
+			slots.reserve(this->capacity);
+		}
+
+		/**
+		 * @brief Counts the next occurrence of the word.
+		 *
+		 * @param word - target word
+		 */
+		void add(const StringView word) {
+			const auto found = slots.find(word);
+
+			if (found != slots.end()) {
+				counts[found->second]++;
+				sift_down(positions[found->second]);
+				return;
+			}
+
+			if (used < capacity) {
+				const usize slot = used++;
+
+				words[slot] = String(word);
+				counts[slot] = 1;
+				errors[slot] = 0;
+				slots.emplace(StringView(words[slot]), slot);
+
+				heap[slot] = slot;
+				positions[slot] = slot;
+				sift_up(slot);
+				return;
+			}
+
+			const usize slot = heap[0];
+			slots.erase(StringView(words[slot]));
+
+			words[slot] = String(word);
+			errors[slot] = counts[slot];
+			counts[slot]++;
+			slots.emplace(StringView(words[slot]), slot);
+
+			sift_down(0);
+		}
+
+		/**
+		 * @brief Gets the most frequent monitored words, ordered from the most frequent and then alphabetically.
+		 *
+		 * @param limit - number of the words to get
+		 * @return Vec<Entry> with the words
+		 */
+		Vec<Entry> top(const usize limit) const {
+			auto entries = Vec<Entry>();
+			entries.reserve(used);
+
+			for (usize slot = 0; slot < used; slot++) {
+				entries.push_back(Entry{ words[slot], counts[slot], errors[slot] });
+			}
+
+			std::sort(entries.begin(), entries.end(), [](const Entry& left, const Entry& right) {
+				if (left.count != right.count) {
+					return left.count > right.count;
+				}
+
+				return left.word < right.word;
+			});
+
+			if (entries.size() > limit) {
+				entries.resize(limit);
+			}
+
+			return entries;
+		}
+	};
+
+	/**
+	 * @brief Count-Min sketch answering how many times a word occurred.
+	 * The estimate is never lower than the real count, and with the probability of 1 - e^-DEPTH
+	 * it's higher by at most e / WIDTH of all the counted words.
+	 */
+	class CountMin {
+	private:
+		static constexpr usize WIDTH = 1 << 16;
+		static constexpr usize DEPTH = 4;
+
+		Vec<u64> table = Vec<u64>(WIDTH * DEPTH, 0);
+
+		/**
+		 * @brief Gets the column of the word in the specific row, derived from two halves of one hash.
+		 */
+		static usize column(const u64 word_hash, const usize row) {
+			const u64 first = word_hash & 0xFFFFFFFFull;
+			const u64 second = word_hash >> 32;
+
+			return (usize)((first + row * (second | 1)) & (WIDTH - 1));
+		}
+
+	public:
+		/**
+		 * @brief Counts the next occurrence of the word.
+		 *
+		 * @param word - target word
+		 */
+		void add(const StringView word) {
+			const u64 word_hash = HashTable::hash(word);
+
+			for (usize row = 0; row < DEPTH; row++) {
+				table[row * WIDTH + column(word_hash, row)]++;
+			}
+		}
+
+		/**
+		 * @brief Estimates the number of the word's occurrences.
+		 *
+		 * @param word - target word
+		 * @return estimated count, never lower than the real one
+		 */
+		u64 estimate(const StringView word) const {
+			const u64 word_hash = HashTable::hash(word);
+			u64 result = UINT64_MAX;
+
+			for (usize row = 0; row < DEPTH; row++) {
+				result = std::min(result, table[row * WIDTH + column(word_hash, row)]);
+			}
+
+			return result;
+		}
+	};
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <functional>
+#include <ostream>
+
 #include "type_aliases.h"
 #include "wrappers.h"
 #include "operations.h"
@@ -20,12 +23,14 @@ enum class Result {
 
 /**
  * @brief Wrapper around the Command's result message.
- * Holds a Result enum indicating in success or failure and result message as a String.
+ * Holds a Result enum indicating in success or failure and result message as a String,
+ * or a writer producing the message straight into the destination stream.
  */
 struct Output {
 private:
 	Result res;
 	String msg;
+	std::function<void(std::ostream&)> writer;
 
 	Output(const Result& result, const String& message) {
 		res = result;
@@ -51,6 +56,21 @@ public:
 		return Output(Result::Ok, message);
 	}
 
+	/**
+	 * @brief Constructs a new Output object with a success result, which message is written by the writer
+	 * straight into the destination stream. Meant for the long messages that shouldn't be held in the memory.
+	 * Everything the writer uses has to stay alive until the Engine's Outputs are grabbed.
+	 *
+	 * @param message_writer - function writing the message into the stream
+	 * @return Output object
+	 */
+	static Output new_ok_writer(const std::function<void(std::ostream&)> message_writer) {
+		auto output = Output(Result::Ok, "");
+		output.writer = message_writer;
+
+		return output;
+	}
+
 	/**
 	 * @brief Constructs a new Output object with a message and error result
 	 *
@@ -67,7 +87,7 @@ public:
 	 * @return true
 	 * @return false
 	 */
-	bool is_ok() {
+	bool is_ok() const {
 		return res == Result::Ok;
 	}
 
@@ -77,7 +97,7 @@ public:
 	 * @return true
 	 * @return false
 	 */
-	bool is_err() {
+	bool is_err() const {
 		return res == Result::Err;
 	}
 
@@ -87,16 +107,47 @@ public:
 	 * @return true
 	 * @return false
 	 */
-	bool is_undefined() {
+	bool is_undefined() const {
 		return res == Result::Undefined;
 	}
 
+	/**
+	 * @brief Checks if the Output has no message to show
+	 *
+	 * @return true
+	 * @return false
+	 */
+	bool is_empty() const {
+		return msg.empty() && !writer;
+	}
+
+	/**
+	 * @brief Writes the message into the stream, without holding it in the memory if the Output has a writer
+	 *
+	 * @param stream - destination stream
+	 */
+	void write_message(std::ostream& stream) const {
+		if (writer) {
+			writer(stream);
+		}
+		else {
+			stream << msg;
+		}
+	}
+
 	/**
 	 * @brief Gets the message
 	 *
 	 * @return Result message
 	 */
 	String get_message() {
+		if (writer) {
+			StringStream ss;
+			writer(ss);
+
+			return ss.str();
+		}
+
 		return msg;
 	}
 };
@@ -107,13 +158,15 @@ public:
  * It holds the name of the flag provided to the Instruction,
  * argument after the flag's name,
  * position of the flag relative to the other flags,
- * and the mod value which is reserved for changing the functionality
+ * the mod value which is reserved for changing the functionality,
+ * and the limit of the listed values (0 for no limit)
  */
 struct Flag {
 	String name;
 	String arg;
 	usize pos;
 	i32 mod = 0;
+	usize limit = 0;
 
 	Flag(const String name, const String argument, usize position) {
 		this->name = name;
@@ -1,6 +1,16 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 #include "type_aliases.h"
+#include "tokenizer.h"
+#include "statistics.h"
+#include "cardinality.h"
+#include "file_operations.cpp"
+#include "result_cache.h"
+#include "checkpoint.h"
 
 
 /**
@@ -11,7 +21,214 @@ struct Operations {
 	String file_in;
 	String file_out;
 
-	String source;
+	StringView source;
 
 	bool is_panicked = false;
+	bool is_streaming = false;
+
+	usize memory_limit = 0;
+	String temp_dir;
+
+	ResultCache::Settings cache;
+	String checkpoint;
+
+	/**
+	 * @brief Results of the source requested by the Commands in their validation,
+	 * so the stream mode can compute all of them in a single read of the source file.
+	 */
+	bool wants_statistics = false;
+	u8 distinct_precision = 0;
+
+	/**
+	 * @brief Loads the source file and points the source at it's content.
+	 *
+	 * @param file_name - name of the source file
+	 */
+	void load_source(const String& file_name) {
+		source_content = File::Content::load_unchecked(file_name);
+		source = source_content->view();
+	}
+
+	/**
+	 * @brief Gets the words of the source, tokenizing it only on the first call of the execution.
+	 * The returned views point into the source, so it shouldn't be modified afterwards.
+	 * Safe to call from the concurrently executed Commands.
+	 *
+	 * @return Tokens of the source shared by all the Commands
+	 */
+	const Tokenizer::Tokens& get_words() {
+		std::call_once(caches->words_once, [this] {
+			caches->words = Tokenizer::split(source);
+			caches->words_ready = true;
+		});
+
+		return caches->words;
+	}
+
+	/**
+	 * @brief Calls the callback for every word of the source, in order, in a memory independent of the source's size.
+	 * The words shared with the other Commands are used if they are ready, otherwise the source is tokenized window by window,
+	 * in the stream mode the source file is tokenized chunk by chunk.
+	 * The views passed to the callback are valid only during the call.
+	 *
+	 * @tparam F - Type of the callback taking (StringView word)
+	 * @param callback - function to call
+	 */
+	template <typename F>
+	void for_each_word(F callback) {
+		if (!is_streaming && caches->words_ready) {
+			for (const StringView word : get_words()) {
+				callback(word);
+			}
+
+			return;
+		}
+
+		if (!is_streaming) {
+			Tokenizer::for_each_window(source, WORDS_WINDOW_SIZE, [&callback](const StringView window) {
+				for (const StringView word : Tokenizer::split(window)) {
+					callback(word);
+				}
+			});
+
+			return;
+		}
+
+		auto splitter = Tokenizer::ChunkSplitter();
+
+		File::for_each_chunk(file_in, File::CHUNK_SIZE, [&splitter, &callback](const char* data, const usize size) {
+			splitter.feed(data, size, callback);
+		});
+
+		splitter.finish(callback);
+	}
+
+	/**
+	 * @brief Gets the counters of the source, scanning it only on the first call of the execution.
+	 * Large sources are scanned on all the cores, in the stream mode the source file is scanned chunk by chunk instead.
+	 * With a checkpoint set, only the part of the source file appended since the previous scan is read.
+	 * Commands using the counters have to request them in their validation by setting wants_statistics.
+	 * Safe to call from the concurrently executed Commands.
+	 *
+	 * @return Counters of the source shared by all the counting Commands
+	 */
+	const Statistics::Counters& get_statistics() {
+		std::call_once(caches->statistics_once, [this] {
+			Statistics::Counters& statistics = caches->statistics;
+
+			if (!checkpoint.empty()) {
+				statistics = Checkpoint::scan_file(file_in, checkpoint);
+			}
+			else if (is_streaming) {
+				scan_stream();
+				statistics = caches->stream_statistics;
+			}
+			else {
+				statistics = Statistics::scan(source);
+			}
+
+			// Streamed and mapped content misses the "\n" that File::read_unchecked appends, so it's counted explicitly
+			if (is_streaming || !checkpoint.empty() || (source_content != nullptr && source_content->is_mapped())) {
+				statistics.lines++;
+				statistics.chars++;
+			}
+		});
+
+		return caches->statistics;
+	}
+
+	/**
+	 * @brief Gets the HyperLogLog sketch of the source's words, sketching them only on the first call of the execution.
+	 * In the stream mode the words are sketched in the same read of the source file as the counters,
+	 * otherwise the words shared with the other Commands are used if they are ready, and the source is sketched on all the cores if not.
+	 * Commands using the sketch have to request it in their validation by setting distinct_precision.
+	 * Safe to call from the concurrently executed Commands.
+	 *
+	 * @return Sketch of the source's words
+	 */
+	const Cardinality::HyperLogLog& get_distinct_sketch() {
+		std::call_once(caches->distinct_once, [this] {
+			if (is_streaming) {
+				scan_stream();
+			}
+			else if (caches->words_ready) {
+				caches->distinct = Cardinality::HyperLogLog(distinct_precision);
+
+				for (const StringView word : get_words()) {
+					caches->distinct.add(word);
+				}
+			}
+			else {
+				caches->distinct = Cardinality::sketch(source, distinct_precision);
+			}
+		});
+
+		return caches->distinct;
+	}
+
+private:
+	/**
+	 * @brief Size of the source windows tokenized at once by for_each_word.
+	 */
+	static constexpr usize WORDS_WINDOW_SIZE = 1024 * 1024;
+
+	/**
+	 * @brief Lazily computed data, filled once per execution by the first Command that needs it.
+	 */
+	struct Caches {
+		std::once_flag words_once;
+		Tokenizer::Tokens words;
+
+		std::atomic<bool> words_ready = false;
+
+		std::once_flag statistics_once;
+		Statistics::Counters statistics;
+
+		std::once_flag distinct_once;
+		Cardinality::HyperLogLog distinct;
+
+		std::once_flag stream_once;
+		Statistics::Counters stream_statistics;
+	};
+
+	/**
+	 * @brief Reads the source file once for all the requested results, in the stream mode.
+	 * The counters are left to the checkpoint if it's set.
+	 */
+	void scan_stream() {
+		std::call_once(caches->stream_once, [this] {
+			const bool counting = wants_statistics && checkpoint.empty();
+			const bool sketching = distinct_precision != 0;
+
+			if (!counting && !sketching) {
+				return;
+			}
+
+			Statistics::Scanner scanner;
+			auto sketch = Cardinality::HyperLogLog(sketching ? distinct_precision : Cardinality::MIN_PRECISION);
+			auto splitter = Tokenizer::ChunkSplitter();
+
+			const auto add_word = [&sketch](const StringView word) {
+				sketch.add(word);
+			};
+
+			File::for_each_chunk(file_in, File::CHUNK_SIZE, [&](const char* data, const usize size) {
+				if (counting) {
+					scanner.feed(data, size);
+				}
+
+				if (sketching) {
+					splitter.feed(data, size, add_word);
+				}
+			});
+
+			splitter.finish(add_word);
+
+			caches->stream_statistics = scanner.finish();
+			caches->distinct = sketch;
+		});
+	}
+
+	std::shared_ptr<const File::Content> source_content;
+	std::unique_ptr<Caches> caches = std::make_unique<Caches>();
 };
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdio>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+
+#include "type_aliases.h"
+
+
+/**
+ * @brief Destination of the Engine's Outputs, writing straight into a file descriptor with large buffered writes.
+ * Only one buffer is held in the memory, no matter how long the Outputs are.
+ */
+class OutputSink : public std::streambuf {
+private:
+	std::FILE* file;
+	bool owns_file;
+	Vec<char> buffer;
+	std::ostream output_stream;
+
+	OutputSink(std::FILE* file, const bool owns_file)
+		: file(file), owns_file(owns_file), buffer(BUFFER_SIZE), output_stream(this) {
+		setp(buffer.data(), buffer.data() + buffer.size());
+	}
+
+	/**
+	 * @brief Writes the buffered bytes into the file.
+	 *
+	 * @return true - If all the bytes were written
+	 * @return false - If the write failed
+	 */
+	bool flush_buffer() {
+		const usize size = pptr() - pbase();
+		const bool written = size == 0 || std::fwrite(pbase(), 1, size, file) == size;
+
+		setp(buffer.data(), buffer.data() + buffer.size());
+		return written;
+	}
+
+protected:
+	int_type overflow(const int_type ch) override {
+		if (!flush_buffer()) {
+			return traits_type::eof();
+		}
+
+		if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+			*pptr() = traits_type::to_char_type(ch);
+			pbump(1);
+		}
+
+		return traits_type::not_eof(ch);
+	}
+
+	std::streamsize xsputn(const char* data, const std::streamsize size) override {
+		if ((usize)size < buffer.size()) {
+			return std::streambuf::xsputn(data, size);
+		}
+
+		if (!flush_buffer()) {
+			return 0;
+		}
+
+		return (std::streamsize)std::fwrite(data, 1, (usize)size, file);
+	}
+
+	int sync() override {
+		const bool written = flush_buffer();
+		return written && std::fflush(file) == 0 ? 0 : -1;
+	}
+
+public:
+	/**
+	 * @brief Size of the write buffer.
+	 */
+	static constexpr usize BUFFER_SIZE = 1024 * 1024;
+
+	OutputSink(const OutputSink&) = delete;
+	OutputSink& operator=(const OutputSink&) = delete;
+
+	~OutputSink() {
+		sync();
+
+		if (owns_file) {
+			std::fclose(file);
+		}
+	}
+
+	/**
+	 * @brief Creates the OutputSink writing into the standard output.
+	 *
+	 * @return OutputSink pointer
+	 */
+	static std::unique_ptr<OutputSink> standard_output() {
+		return std::unique_ptr<OutputSink>(new OutputSink(stdout, false));
+	}
+
+	/**
+	 * @brief Creates the OutputSink overwriting everything in the specific file.
+	 *
+	 * @param file_name - name of the file to write
+	 * @return OutputSink pointer, nullptr if the file can't be opened
+	 */
+	static std::unique_ptr<OutputSink> open_file(const String& file_name) {
+		std::FILE* file = std::fopen(file_name.c_str(), "w");
+
+		if (file == nullptr) {
+			return nullptr;
+		}
+
+		return std::unique_ptr<OutputSink>(new OutputSink(file, true));
+	}
+
+	/**
+	 * @brief Gets the stream writing into this sink.
+	 *
+	 * @return std::ostream reference
+	 */
+	std::ostream& stream() {
+		return output_stream;
+	}
+};
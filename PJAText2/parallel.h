@@ -0,0 +1,252 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "type_aliases.h"
+#include "tokenizer.h"
+
+
+/**
+ * @brief Helpers for splitting the work on a text between all the cores.
+ */
+namespace Parallel {
+
+	/**
+	 * @brief Minimal size of a part worth a separate thread.
+	 */
+	const usize MIN_PART_SIZE = 1024 * 1024;
+
+	/**
+	 * @brief Gets the number of threads that can run concurrently.
+	 *
+	 * @return number of the hardware threads, at least 1
+	 */
+	inline usize thread_count() {
+		const usize count = std::thread::hardware_concurrency();
+		return count == 0 ? 1 : count;
+	}
+
+	/**
+	 * @brief Gets the number of parts the text of a specific size should be split into.
+	 *
+	 * @param size - size of the text
+	 * @return number of the parts, at least 1
+	 */
+	inline usize part_count(const usize size) {
+		const usize by_size = size / MIN_PART_SIZE;
+
+		if (by_size == 0) {
+			return 1;
+		}
+
+		return by_size < thread_count() ? by_size : thread_count();
+	}
+
+	/**
+	 * @brief Splits the text into the parts of a similar size.
+	 * Every split point is moved forward to the next whitespace, so no word is ever cut in two.
+	 *
+	 * @param text - target text
+	 * @param parts - wanted number of the parts
+	 * @return Vec<StringView> with the parts, there can be less of them than wanted
+	 */
+	inline Vec<StringView> split_at_spaces(const StringView text, const usize parts) {
+		auto result = Vec<StringView>();
+		usize begin = 0;
+
+		for (usize i = 1; i <= parts && begin < text.size(); i++) {
+			usize end = i == parts ? text.size() : text.size() / parts * i;
+
+			if (end < begin) {
+				end = begin;
+			}
+
+			while (end < text.size() && !Tokenizer::__Scan::is_space(text[end])) {
+				end++;
+			}
+
+			if (end > begin) {
+				result.push_back(text.substr(begin, end - begin));
+			}
+
+			begin = end;
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief Calls the callback for every index from 0 to count, each on a separate thread.
+	 * The calling thread handles the index 0 and waits for all the others.
+	 *
+	 * @tparam F - Type of the callback taking (usize index)
+	 * @param count - number of the indexes
+	 * @param callback - function to call
+	 */
+	template <typename F>
+	void for_each_index(const usize count, F callback) {
+		auto threads = Vec<std::thread>();
+
+		for (usize i = 1; i < count; i++) {
+			threads.emplace_back(callback, i);
+		}
+
+		if (count != 0) {
+			callback(0);
+		}
+
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+	}
+
+	/**
+	 * @brief Fixed-size pool of worker threads executing the submitted tasks in the submission order.
+	 */
+	class ThreadPool {
+	private:
+		Vec<std::thread> workers;
+		std::deque<std::function<void()>> tasks;
+		std::mutex mutex;
+		std::condition_variable task_ready;
+		std::condition_variable tasks_done;
+		usize pending = 0;
+		bool stopping = false;
+
+		/**
+		 * @brief Loop of a single worker, takes the tasks until the pool is destroyed.
+		 */
+		void work() {
+			while (true) {
+				std::function<void()> task;
+
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					task_ready.wait(lock, [this] { return stopping || !tasks.empty(); });
+
+					if (tasks.empty()) {
+						return;
+					}
+
+					task = std::move(tasks.front());
+					tasks.pop_front();
+				}
+
+				task();
+
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if (--pending == 0) {
+						tasks_done.notify_all();
+					}
+				}
+			}
+		}
+
+	public:
+		/**
+		 * @brief Constructs a new ThreadPool object and starts it's workers.
+		 *
+		 * @param size - number of the worker threads
+		 */
+		explicit ThreadPool(const usize size) {
+			for (usize i = 0; i < size; i++) {
+				workers.emplace_back([this] { work(); });
+			}
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		~ThreadPool() {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stopping = true;
+			}
+
+			task_ready.notify_all();
+
+			for (std::thread& worker : workers) {
+				worker.join();
+			}
+		}
+
+		/**
+		 * @brief Queues the task to be executed by one of the workers.
+		 *
+		 * @param task - function to execute
+		 */
+		void submit(std::function<void()> task) {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				tasks.push_back(std::move(task));
+				pending++;
+			}
+
+			task_ready.notify_one();
+		}
+
+		/**
+		 * @brief Blocks until all the submitted tasks are finished.
+		 */
+		void wait() {
+			std::unique_lock<std::mutex> lock(mutex);
+			tasks_done.wait(lock, [this] { return pending == 0; });
+		}
+
+		/**
+		 * @brief Executes the tasks on the workers and blocks until all of them are finished.
+		 * Unlike wait(), it waits only for these tasks, so it's safe to call from many threads at once.
+		 *
+		 * @param tasks - functions to execute
+		 */
+		void run(const Vec<std::function<void()>>& tasks) {
+			struct Group {
+				std::mutex mutex;
+				std::condition_variable done;
+				usize remaining;
+			};
+
+			auto group = std::make_shared<Group>();
+			group->remaining = tasks.size();
+
+			for (const auto& task : tasks) {
+				submit([group, task] {
+					task();
+
+					std::lock_guard<std::mutex> lock(group->mutex);
+					if (--group->remaining == 0) {
+						group->done.notify_all();
+					}
+				});
+			}
+
+			std::unique_lock<std::mutex> lock(group->mutex);
+			group->done.wait(lock, [&group] { return group->remaining == 0; });
+		}
+
+		/**
+		 * @brief Gets the number of the worker threads.
+		 *
+		 * @return number of the workers
+		 */
+		usize size() const {
+			return workers.size();
+		}
+	};
+
+	/**
+	 * @brief Gets the thread pool shared by the whole process, it's created on the first use.
+	 *
+	 * @return ThreadPool reference
+	 */
+	inline ThreadPool& shared_pool() {
+		static ThreadPool pool(thread_count());
+		return pool;
+	}
+}
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <ostream>
+#include <streambuf>
+
+#include "type_aliases.h"
+#include "hash_table.h"
+#include "file_operations.cpp"
+
+
+/**
+ * @brief On-disk cache of the rendered Outputs.
+ * Every entry is keyed by the hash of the source file's content and of the normalized instruction,
+ * so changing the file or the flags always misses. The least recently used files are removed above the size limit.
+ *
+ * Files in the cache directory:
+ * <key>.out - rendered Outputs of a single execution
+ * <path hash>.src - modification time, size and content hash of a source file, for the validation by the metadata
+ */
+namespace ResultCache {
+
+	/**
+	 * @brief Size limit of the cache when none was set.
+	 */
+	const usize DEFAULT_SIZE_LIMIT = 256ull * 1024 * 1024;
+
+	/**
+	 * @brief Options of the cache.
+	 * With stat_only set, a source file with the same modification time and size as before isn't read again,
+	 * it's previous content hash is used instead.
+	 */
+	struct Settings {
+		String directory;
+		usize size_limit = DEFAULT_SIZE_LIMIT;
+		bool stat_only = false;
+	};
+
+	namespace __Files {
+		inline String hex(const u64 value) {
+			StringStream ss;
+			ss << std::hex << std::setw(16) << std::setfill('0') << value;
+
+			return ss.str();
+		}
+
+		inline std::filesystem::path path(const Settings& settings, const String& name) {
+			return std::filesystem::path(settings.directory) / name;
+		}
+
+		/**
+		 * @brief Hashes the whole content of the file, reading it chunk by chunk.
+		 */
+		inline u64 content_hash(const String& file_name) {
+			u64 result = 0;
+			u64 chunk = 0;
+
+			File::for_each_chunk(file_name, File::CHUNK_SIZE, [&result, &chunk](const char* data, const usize size) {
+				const u64 chunk_hash = HashTable::hash(StringView(data, size)) ^ (++chunk * 0x9E3779B97F4A7C15ull);
+
+				result = (result << 29 | result >> 35) ^ chunk_hash;
+				result *= 0xD6E8FEB86659FD93ull;
+			});
+
+			return result;
+		}
+
+		/**
+		 * @brief Stream buffer passing everything to the destination, and copying it into the entry while it fits into the limit.
+		 */
+		class Tee : public std::streambuf {
+		private:
+			std::streambuf* destination;
+			std::streambuf* entry;
+			usize limit;
+			usize size = 0;
+
+		protected:
+			int_type overflow(const int_type ch) override {
+				if (traits_type::eq_int_type(ch, traits_type::eof())) {
+					return traits_type::not_eof(ch);
+				}
+
+				const char data = traits_type::to_char_type(ch);
+				return xsputn(&data, 1) == 1 ? ch : traits_type::eof();
+			}
+
+			std::streamsize xsputn(const char* data, const std::streamsize count) override {
+				size += (usize)count;
+
+				if (entry != nullptr && (size > limit || entry->sputn(data, count) != count)) {
+					entry = nullptr;
+				}
+
+				return destination->sputn(data, count);
+			}
+
+		public:
+			Tee(std::ostream& destination, std::ostream& entry, const usize limit)
+				: destination(destination.rdbuf()), entry(entry.rdbuf()), limit(limit) {}
+
+			/**
+			 * @brief Checks if the entry got everything that was written.
+			 */
+			bool is_complete() const {
+				return entry != nullptr;
+			}
+		};
+	}
+
+	/**
+	 * @brief Gets the content hash of the source file.
+	 * In the stat only mode the hash stored for the file is reused if it's modification time and size haven't changed.
+	 *
+	 * @param settings - options of the cache
+	 * @param file_name - name of the source file
+	 * @return Option<u64>(Some) - hash of the content
+	 * @return Option<u64>(None) - If the file can't be checked
+	 */
+	inline Option<u64> source_hash(const Settings& settings, const String& file_name) {
+		std::error_code error;
+		const auto absolute = std::filesystem::absolute(file_name, error).string();
+		const auto size = std::filesystem::file_size(file_name, error);
+		const auto modified = std::filesystem::last_write_time(file_name, error).time_since_epoch().count();
+
+		if (error) {
+			return Option<u64>::none();
+		}
+
+		const auto metadata_path = __Files::path(settings, __Files::hex(HashTable::hash(absolute)) + ".src");
+
+		if (settings.stat_only) {
+			IFStream metadata(metadata_path);
+			i64 stored_modified = 0;
+			u64 stored_size = 0;
+			u64 stored_hash = 0;
+
+			if (metadata >> stored_modified >> stored_size >> stored_hash && stored_modified == (i64)modified && stored_size == (u64)size) {
+				std::filesystem::last_write_time(metadata_path, std::filesystem::file_time_type::clock::now(), error);
+				return Option<u64>::some(stored_hash);
+			}
+		}
+
+		const u64 hash = __Files::content_hash(file_name) ^ (u64)size;
+
+		File::write_atomically(metadata_path, [modified, size, hash](std::ostream& stream) {
+			stream << (i64)modified << " " << (u64)size << " " << hash << "\n";
+		});
+
+		return Option<u64>::some(hash);
+	}
+
+	/**
+	 * @brief Gets the key of the entry.
+	 *
+	 * @param source - content hash of the source file
+	 * @param instruction - normalized instruction
+	 * @return key of the entry
+	 */
+	inline String entry_key(const u64 source, const String& instruction) {
+		return __Files::hex(source) + __Files::hex(HashTable::hash(instruction));
+	}
+
+	/**
+	 * @brief Copies the stored Outputs into the stream, and marks the entry as recently used.
+	 *
+	 * @param settings - options of the cache
+	 * @param key - key of the entry
+	 * @param stream - destination stream
+	 * @return true - If the entry was found
+	 * @return false - If there is no such entry
+	 */
+	inline bool read(const Settings& settings, const String& key, std::ostream& stream) {
+		const auto entry_path = __Files::path(settings, key + ".out");
+		IFStream entry(entry_path, std::ios::binary);
+
+		if (!entry.is_open()) {
+			return false;
+		}
+
+		if (entry.peek() != IFStream::traits_type::eof()) {
+			stream << entry.rdbuf();
+		}
+
+		std::error_code error;
+		std::filesystem::last_write_time(entry_path, std::filesystem::file_time_type::clock::now(), error);
+
+		return true;
+	}
+
+	/**
+	 * @brief Removes the least recently used entries and source metadata until the cache fits into the size limit.
+	 *
+	 * @param settings - options of the cache
+	 */
+	inline void evict(const Settings& settings) {
+		struct Entry {
+			std::filesystem::path path;
+			std::filesystem::file_time_type used;
+			usize size;
+		};
+
+		auto entries = Vec<Entry>();
+		usize total = 0;
+		std::error_code error;
+
+		for (const auto& file : std::filesystem::directory_iterator(settings.directory, error)) {
+			if (file.path().extension() != ".out" && file.path().extension() != ".src") {
+				continue;
+			}
+
+			std::error_code entry_error;
+			const usize size = (usize)file.file_size(entry_error);
+			const auto used = file.last_write_time(entry_error);
+
+			if (!entry_error) {
+				entries.push_back(Entry{ file.path(), used, size });
+				total += size;
+			}
+		}
+
+		if (total <= settings.size_limit) {
+			return;
+		}
+
+		std::sort(entries.begin(), entries.end(), [](const Entry& left, const Entry& right) {
+			return left.used < right.used;
+		});
+
+		for (const Entry& entry : entries) {
+			if (total <= settings.size_limit) {
+				break;
+			}
+
+			std::filesystem::remove(entry.path, error);
+			total -= entry.size;
+		}
+	}
+
+	/**
+	 * @brief Writes the Outputs into the stream, and at the same time stores them as the entry, evicting the old entries if needed.
+	 * The Outputs are written only once. An entry larger than the size limit isn't stored at all.
+	 *
+	 * @tparam W - Type of the callback taking (std::ostream& stream)
+	 * @param settings - options of the cache
+	 * @param key - key of the entry
+	 * @param stream - destination stream
+	 * @param write_outputs - function writing the Outputs into the stream
+	 * @return true - If the entry was stored
+	 * @return false - If the entry was too large, or couldn't be written
+	 */
+	template <typename W>
+	bool write_through(const Settings& settings, const String& key, std::ostream& stream, W write_outputs) {
+		const bool stored = File::write_atomically(__Files::path(settings, key + ".out"), [&settings, &stream, &write_outputs](std::ostream& entry) {
+			__Files::Tee tee(stream, entry, settings.size_limit);
+			std::ostream both(&tee);
+
+			write_outputs(both);
+
+			if (!both) {
+				stream.setstate(std::ios::badbit);
+			}
+
+			if (!tee.is_complete()) {
+				// Discards the partial entry
+				entry.setstate(std::ios::failbit);
+			}
+		});
+
+		if (stored) {
+			evict(settings);
+		}
+
+		return stored;
+	}
+}
@@ -0,0 +1,396 @@
+#pragma once
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PJA_SERVER_SUPPORTED
+#endif
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+
+#ifdef PJA_SERVER_SUPPORTED
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "type_aliases.h"
+#include "tokenizer.h"
+#include "parallel.h"
+#include "engine.h"
+
+
+/**
+ * @brief Server mode executing the instructions sent over a local Unix domain socket.
+ *
+ * Protocol: every message is a frame made of a 4 byte big-endian length and that many bytes.
+ * A request is one frame with an instruction in the same syntax as the program's arguments.
+ * The response is streamed back as any number of non-empty frames with the results, ended by an empty frame.
+ * A connection can send any number of requests, one after another.
+ * A worker is taken only for a single request, so idle connections never hold the workers.
+ */
+namespace Server {
+
+	const String CALLER_VALUE = "-srv";
+	const String ALIAS_VALUE = "--serve";
+
+	/**
+	 * @brief Longest accepted request.
+	 */
+	const usize MAX_REQUEST_SIZE = 1024 * 1024;
+
+	/**
+	 * @brief Pause before accepting again when the process or the system is out of the descriptors or the memory.
+	 */
+	const std::chrono::milliseconds ACCEPT_BACKOFF = std::chrono::milliseconds(100);
+
+	/**
+	 * @brief Longest time a started request can take to arrive, or a response can wait to be sent, before the connection is closed.
+	 */
+	const i64 TRANSFER_TIMEOUT_SECONDS = 30;
+
+#ifdef PJA_SERVER_SUPPORTED
+	namespace __Socket {
+		inline bool write_all(const int socket, const char* data, usize size) {
+			while (size != 0) {
+#ifdef MSG_NOSIGNAL
+				const ssize_t written = ::send(socket, data, size, MSG_NOSIGNAL);
+#else
+				const ssize_t written = ::send(socket, data, size, 0);
+#endif
+				if (written <= 0) {
+					return false;
+				}
+
+				data += written;
+				size -= (usize)written;
+			}
+
+			return true;
+		}
+
+		inline bool read_all(const int socket, char* data, usize size) {
+			while (size != 0) {
+				const ssize_t read = ::recv(socket, data, size, 0);
+
+				if (read <= 0) {
+					return false;
+				}
+
+				data += read;
+				size -= (usize)read;
+			}
+
+			return true;
+		}
+
+		inline bool write_frame(const int socket, const char* data, const usize size) {
+			const unsigned char header[4] = {
+				(unsigned char)(size >> 24), (unsigned char)(size >> 16), (unsigned char)(size >> 8), (unsigned char)size
+			};
+
+			return write_all(socket, (const char*)header, 4) && (size == 0 || write_all(socket, data, size));
+		}
+
+		/**
+		 * @brief Reads the next request.
+		 *
+		 * @param socket - connected socket
+		 * @param request - filled with the request's content
+		 * @return true - If the request was read
+		 * @return false - If the connection was closed, or the request is invalid
+		 */
+		inline bool read_frame(const int socket, String& request) {
+			unsigned char header[4];
+
+			if (!read_all(socket, (char*)header, 4)) {
+				return false;
+			}
+
+			const usize size = ((usize)header[0] << 24) | ((usize)header[1] << 16) | ((usize)header[2] << 8) | header[3];
+			if (size > MAX_REQUEST_SIZE) {
+				return false;
+			}
+
+			request.resize(size);
+			return size == 0 || read_all(socket, &request[0], size);
+		}
+
+		/**
+		 * @brief Stream buffer sending everything written into it as the response frames.
+		 */
+		class FrameWriter : public std::streambuf {
+		private:
+			static constexpr usize BUFFER_SIZE = 64 * 1024;
+
+			int socket;
+			Vec<char> buffer = Vec<char>(BUFFER_SIZE);
+			bool failed = false;
+
+			bool send_buffer() {
+				const usize size = pptr() - pbase();
+
+				if (size != 0 && !failed) {
+					failed = !write_frame(socket, pbase(), size);
+				}
+
+				setp(buffer.data(), buffer.data() + buffer.size());
+				return !failed;
+			}
+
+		protected:
+			int_type overflow(const int_type ch) override {
+				if (!send_buffer()) {
+					return traits_type::eof();
+				}
+
+				if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+					*pptr() = traits_type::to_char_type(ch);
+					pbump(1);
+				}
+
+				return traits_type::not_eof(ch);
+			}
+
+			int sync() override {
+				return send_buffer() ? 0 : -1;
+			}
+
+		public:
+			explicit FrameWriter(const int socket) : socket(socket) {
+				setp(buffer.data(), buffer.data() + buffer.size());
+			}
+
+			/**
+			 * @brief Sends the rest of the response and the ending empty frame.
+			 *
+			 * @return true - If the whole response was sent
+			 * @return false - If the connection failed
+			 */
+			bool finish() {
+				return send_buffer() && write_frame(socket, nullptr, 0);
+			}
+		};
+	}
+
+	/**
+	 * @brief Serves the next request of the connection, which is ready to be read.
+	 *
+	 * @param engine - Engine with all the Commands included
+	 * @param socket - connected socket
+	 * @return true - If the response was sent, and the connection can send the next request
+	 * @return false - If the connection was closed, or failed
+	 */
+	inline bool serve_request(const Engine& engine, const int socket) {
+		String request;
+
+		if (!__Socket::read_frame(socket, request)) {
+			return false;
+		}
+
+		auto args = Vec<String>();
+		for (const StringView arg : Tokenizer::split(request)) {
+			args.emplace_back(arg);
+		}
+
+		__Socket::FrameWriter writer(socket);
+		std::ostream stream(&writer);
+
+		engine.execute(args, stream);
+
+		return writer.finish();
+	}
+
+	/**
+	 * @brief Listens on the socket and executes the requests until the process is stopped.
+	 * The idle connections are polled by the listening thread, and every request that arrives is served by a pool of workers,
+	 * all sharing the single warmed-up Engine. After the response the connection goes back to the polled ones,
+	 * so any number of idle connections can stay open without blocking the others.
+	 * Accepting is retried on interruptions and aborted connections, and after a pause when out of the descriptors or the memory,
+	 * any other failure stops the server once the requests in progress are served.
+	 *
+	 * @param socket_path - path of the Unix domain socket, an existing file there is replaced
+	 * @param engine - Engine with all the Commands included
+	 * @return true - If the server was running and stopped
+	 * @return false - If the socket can't be created
+	 */
+	inline bool run(const String& socket_path, const Engine& engine) {
+		sockaddr_un address = {};
+		address.sun_family = AF_UNIX;
+
+		if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+			return false;
+		}
+
+		std::copy(socket_path.begin(), socket_path.end(), address.sun_path);
+
+		const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		if (listener < 0) {
+			return false;
+		}
+
+		::unlink(socket_path.c_str());
+
+		int wake[2];
+		if (::bind(listener, (const sockaddr*)&address, sizeof(address)) != 0 || ::listen(listener, SOMAXCONN) != 0 || ::pipe(wake) != 0) {
+			::close(listener);
+			return false;
+		}
+
+		::fcntl(wake[0], F_SETFL, O_NONBLOCK);
+		::fcntl(wake[1], F_SETFL, O_NONBLOCK);
+		std::signal(SIGPIPE, SIG_IGN);
+
+		std::deque<int> requests;
+		auto returned = Vec<int>();
+		std::mutex mutex;
+		std::condition_variable request_ready;
+		bool stopping = false;
+
+		auto workers = Vec<std::thread>();
+		for (usize i = 0; i < Parallel::thread_count(); i++) {
+			workers.emplace_back([&] {
+				while (true) {
+					int socket;
+
+					{
+						std::unique_lock<std::mutex> lock(mutex);
+						request_ready.wait(lock, [&requests, &stopping] { return !requests.empty() || stopping; });
+
+						if (requests.empty()) {
+							return;
+						}
+
+						socket = requests.front();
+						requests.pop_front();
+					}
+
+					if (!serve_request(engine, socket)) {
+						::close(socket);
+						continue;
+					}
+
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						returned.push_back(socket);
+					}
+
+					// Wakes up the polling, so the connection is polled again
+					const char signal = 0;
+					while (::write(wake[1], &signal, 1) < 0 && errno == EINTR) {}
+				}
+			});
+		}
+
+		const timeval timeout = { (time_t)TRANSFER_TIMEOUT_SECONDS, 0 };
+		auto idle = Vec<int>();
+		auto polled = Vec<pollfd>();
+
+		while (true) {
+			polled.clear();
+			polled.push_back(pollfd{ listener, POLLIN, 0 });
+			polled.push_back(pollfd{ wake[0], POLLIN, 0 });
+
+			for (const int socket : idle) {
+				polled.push_back(pollfd{ socket, POLLIN, 0 });
+			}
+
+			if (::poll(polled.data(), (nfds_t)polled.size(), -1) < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+
+				break;
+			}
+
+			auto still_idle = Vec<int>();
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+
+				for (usize i = 2; i < polled.size(); i++) {
+					if (polled[i].revents != 0) {
+						requests.push_back(polled[i].fd);
+					}
+					else {
+						still_idle.push_back(polled[i].fd);
+					}
+				}
+
+				if (polled[1].revents != 0) {
+					char drained[64];
+					while (::read(wake[0], drained, sizeof(drained)) > 0) {}
+
+					still_idle.insert(still_idle.end(), returned.begin(), returned.end());
+					returned.clear();
+				}
+			}
+
+			request_ready.notify_all();
+			idle = std::move(still_idle);
+
+			if (polled[0].revents == 0) {
+				continue;
+			}
+
+			const int socket = ::accept(listener, nullptr, nullptr);
+
+			if (socket < 0) {
+				if (errno == EINTR || errno == ECONNABORTED || errno == EAGAIN) {
+					continue;
+				}
+
+				if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+					std::this_thread::sleep_for(ACCEPT_BACKOFF);
+					continue;
+				}
+
+				break;
+			}
+
+			// A started request or a response can't hold a worker forever
+			::setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+			::setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+			idle.push_back(socket);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+
+		request_ready.notify_all();
+
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+
+		for (const int socket : idle) {
+			::close(socket);
+		}
+
+		for (const int socket : returned) {
+			::close(socket);
+		}
+
+		::close(wake[0]);
+		::close(wake[1]);
+		::close(listener);
+
+		return true;
+	}
+#else
+	inline bool run(const String& socket_path, const Engine& engine) {
+		return false;
+	}
+#endif
+}
@@ -0,0 +1,357 @@
+#pragma once
+
+#include <algorithm>
+
+#include "type_aliases.h"
+#include "tokenizer.h"
+#include "parallel.h"
+
+
+/**
+ * @brief Sorting algorithms specialized for the token lists.
+ */
+namespace Sorting {
+
+	namespace __Radix {
+		/**
+		 * @brief Ranges smaller than this are finished by a comparison sort.
+		 */
+		const usize SMALL_RANGE = 32;
+
+		/**
+		 * @brief Number of the buckets, the bucket 0 is for the words that ended before the current depth.
+		 */
+		const usize BUCKETS = 257;
+
+		/**
+		 * @brief Gets the bucket of the word at the specific depth.
+		 *
+		 * @param word - target word
+		 * @param depth - index of the byte
+		 * @return 0 if the word is too short, otherwise the byte value + 1
+		 */
+		inline u16 bucket_of(const StringView word, const usize depth) {
+			return depth < word.size() ? (u16)((unsigned char)word[depth] + 1) : 0;
+		}
+
+		/**
+		 * @brief Sorts a small range by comparing the words' suffixes from the specific depth.
+		 */
+		inline void sort_small(StringView* begin, StringView* end, const usize depth, const bool descending) {
+			if (descending) {
+				std::sort(begin, end, [depth](const StringView left, const StringView right) {
+					return left.substr(depth) > right.substr(depth);
+				});
+			}
+			else {
+				std::sort(begin, end, [depth](const StringView left, const StringView right) {
+					return left.substr(depth) < right.substr(depth);
+				});
+			}
+		}
+
+		/**
+		 * @brief MSD radix sort of the range, all the words in the range share the first "depth" bytes.
+		 * Every bucket except the largest one is sorted recursively, the largest one is continued in the loop,
+		 * so the recursion stays logarithmic even for the words with long common prefixes.
+		 *
+		 * @param data - first word of the range
+		 * @param buffer - scratch space of at least the range's size
+		 * @param keys - scratch space for the buckets of at least the range's size
+		 * @param size - size of the range
+		 * @param depth - index of the byte to distribute by
+		 * @param descending - true for the reverse order
+		 */
+		inline void sort(StringView* data, StringView* buffer, u16* keys, usize size, usize depth, const bool descending) {
+			while (size >= SMALL_RANGE) {
+				usize counts[BUCKETS] = {};
+
+				for (usize i = 0; i < size; i++) {
+					keys[i] = bucket_of(data[i], depth);
+					counts[keys[i]]++;
+				}
+
+				usize starts[BUCKETS];
+				usize offset = 0;
+
+				for (usize step = 0; step < BUCKETS; step++) {
+					const usize bucket = descending ? BUCKETS - 1 - step : step;
+
+					starts[bucket] = offset;
+					offset += counts[bucket];
+				}
+
+				usize positions[BUCKETS];
+				std::copy(std::begin(starts), std::end(starts), std::begin(positions));
+
+				for (usize i = 0; i < size; i++) {
+					buffer[positions[keys[i]]++] = data[i];
+				}
+
+				std::copy(buffer, buffer + size, data);
+
+				usize largest = 1;
+				for (usize bucket = 2; bucket < BUCKETS; bucket++) {
+					if (counts[bucket] > counts[largest]) {
+						largest = bucket;
+					}
+				}
+
+				for (usize bucket = 1; bucket < BUCKETS; bucket++) {
+					if (bucket != largest && counts[bucket] > 1) {
+						sort(data + starts[bucket], buffer, keys, counts[bucket], depth + 1, descending);
+					}
+				}
+
+				data += starts[largest];
+				size = counts[largest];
+				depth++;
+			}
+
+			if (size > 1) {
+				sort_small(data, data + size, depth, descending);
+			}
+		}
+	}
+
+	/**
+	 * @brief Sorts the words lexicographically (by the unsigned bytes, same as std::string_view comparison)
+	 * with the MSD radix sort. Only the views are moved, the words' bytes are never copied.
+	 *
+	 * @param words - first word of the range to sort
+	 * @param size - size of the range
+	 * @param descending - true for the reverse order
+	 */
+	inline void radix_sort(StringView* words, const usize size, const bool descending) {
+		if (size < 2) {
+			return;
+		}
+
+		auto buffer = Tokenizer::Tokens(size);
+		auto keys = Vec<u16>(size);
+
+		__Radix::sort(words, buffer.data(), keys.data(), size, 0, descending);
+	}
+
+	/**
+	 * @brief Longest words handled by the counting sort, longer ones fall back to a comparison sort.
+	 */
+	const usize MAX_COUNTED_LENGTH = 64 * 1024;
+
+	/**
+	 * @brief Stable sort of the words by their length, with the counting sort.
+	 * Words of the same length keep their order from the source.
+	 *
+	 * @param words - first word of the range to sort
+	 * @param size - size of the range
+	 * @param descending - true for the longest words first
+	 */
+	inline void length_sort(StringView* words, const usize size, const bool descending) {
+		if (size < 2) {
+			return;
+		}
+
+		usize max_length = 0;
+		for (usize i = 0; i < size; i++) {
+			max_length = std::max(max_length, words[i].size());
+		}
+
+		if (max_length > MAX_COUNTED_LENGTH) {
+			std::stable_sort(words, words + size, [descending](const StringView left, const StringView right) {
+				return descending ? left.size() > right.size() : left.size() < right.size();
+			});
+			return;
+		}
+
+		auto counts = Vec<usize>(max_length + 1);
+		for (usize i = 0; i < size; i++) {
+			counts[words[i].size()]++;
+		}
+
+		usize offset = 0;
+		for (usize step = 0; step <= max_length; step++) {
+			const usize length = descending ? max_length - step : step;
+			const usize count = counts[length];
+
+			counts[length] = offset;
+			offset += count;
+		}
+
+		auto sorted = Tokenizer::Tokens(size);
+		for (usize i = 0; i < size; i++) {
+			sorted[counts[words[i].size()]++] = words[i];
+		}
+
+		std::copy(sorted.begin(), sorted.end(), words);
+	}
+
+	/**
+	 * @brief Minimal number of the words worth a separate sorting thread.
+	 */
+	const usize MIN_PARALLEL_RUN = 256 * 1024;
+
+	/**
+	 * @brief Sorts the words on all the cores: every thread sorts it's own run,
+	 * and then the runs are merged pairwise, with all the merges of a round running in parallel.
+	 * The merges are stable, so the result is identical to the sequential sort.
+	 *
+	 * @param words - words to sort
+	 * @param by_length - true to sort by the length, false to sort lexicographically
+	 * @param descending - true for the reverse order
+	 * @param runs - number of the runs to sort concurrently
+	 */
+	inline void parallel_sort(Tokenizer::Tokens& words, const bool by_length, const bool descending, const usize runs) {
+		auto bounds = Vec<usize>();
+		for (usize i = 0; i <= runs; i++) {
+			bounds.push_back(words.size() / runs * i);
+		}
+		bounds.back() = words.size();
+
+		Parallel::for_each_index(runs, [&words, &bounds, by_length, descending](const usize index) {
+			StringView* run = words.data() + bounds[index];
+			const usize size = bounds[index + 1] - bounds[index];
+
+			if (by_length) {
+				length_sort(run, size, descending);
+			}
+			else {
+				radix_sort(run, size, descending);
+			}
+		});
+
+		const auto compare = [by_length, descending](const StringView left, const StringView right) {
+			if (by_length) {
+				return descending ? left.size() > right.size() : left.size() < right.size();
+			}
+
+			return descending ? left > right : left < right;
+		};
+
+		auto buffer = Tokenizer::Tokens(words.size());
+
+		while (bounds.size() > 2) {
+			const usize pairs = (bounds.size() - 1) / 2;
+			auto merged_bounds = Vec<usize>();
+
+			for (usize i = 0; i < bounds.size(); i += 2) {
+				merged_bounds.push_back(bounds[i]);
+			}
+			if (merged_bounds.back() != words.size()) {
+				merged_bounds.push_back(words.size());
+			}
+
+			Parallel::for_each_index(merged_bounds.size() - 1, [&words, &buffer, &bounds, &compare, pairs](const usize index) {
+				const usize begin = bounds[index * 2];
+
+				if (index < pairs) {
+					const usize middle = bounds[index * 2 + 1];
+					const usize end = bounds[index * 2 + 2];
+
+					std::merge(
+						words.begin() + begin, words.begin() + middle,
+						words.begin() + middle, words.begin() + end,
+						buffer.begin() + begin,
+						compare
+					);
+				}
+				else {
+					std::copy(words.begin() + begin, words.end(), buffer.begin() + begin);
+				}
+			});
+
+			words.swap(buffer);
+			bounds = merged_bounds;
+		}
+	}
+
+	/**
+	 * @brief Sorts the words for the listings, on all the cores if there is enough of them.
+	 *
+	 * @param words - words to sort
+	 * @param by_length - true to sort by the length (stable), false to sort lexicographically
+	 * @param descending - true for the reverse order
+	 */
+	inline void sort_words(Tokenizer::Tokens& words, const bool by_length, const bool descending) {
+		const usize runs = std::min(Parallel::thread_count(), words.size() / MIN_PARALLEL_RUN);
+
+		if (runs > 1) {
+			parallel_sort(words, by_length, descending, runs);
+		}
+		else if (by_length) {
+			length_sort(words.data(), words.size(), descending);
+		}
+		else {
+			radix_sort(words.data(), words.size(), descending);
+		}
+	}
+
+	/**
+	 * @brief Keeps only the first "count" words of the sorted order, and sorts just them.
+	 * The rest of the words is dropped by a linear selection, so the whole table is never sorted.
+	 * The result is identical to the first "count" words of sort_words, the ties in length keep their order from the source.
+	 *
+	 * @param words - words to select from, resized to at most "count" sorted words
+	 * @param count - number of the words to keep
+	 * @param by_length - true to sort by the length (stable), false to sort lexicographically
+	 * @param descending - true for the reverse order
+	 */
+	inline void top_words(Tokenizer::Tokens& words, const usize count, const bool by_length, const bool descending) {
+		if (count >= words.size()) {
+			sort_words(words, by_length, descending);
+			return;
+		}
+
+		if (!by_length) {
+			const auto compare = [descending](const StringView left, const StringView right) {
+				return descending ? left > right : left < right;
+			};
+
+			if (count != 0) {
+				std::nth_element(words.begin(), words.begin() + (count - 1), words.end(), compare);
+			}
+
+			words.resize(count);
+			radix_sort(words.data(), words.size(), descending);
+			return;
+		}
+
+		if (count == 0) {
+			words.clear();
+			return;
+		}
+
+		// Length of the last kept word, the words of this length are taken in the source order
+		auto lengths = Vec<usize>(words.size());
+		for (usize i = 0; i < words.size(); i++) {
+			lengths[i] = words[i].size();
+		}
+
+		const auto compare_lengths = [descending](const usize left, const usize right) {
+			return descending ? left > right : left < right;
+		};
+
+		std::nth_element(lengths.begin(), lengths.begin() + (count - 1), lengths.end(), compare_lengths);
+		const usize boundary = lengths[count - 1];
+
+		usize ties = count;
+		for (const StringView word : words) {
+			if (compare_lengths(word.size(), boundary)) {
+				ties--;
+			}
+		}
+
+		usize kept = 0;
+		for (const StringView word : words) {
+			if (compare_lengths(word.size(), boundary)) {
+				words[kept++] = word;
+			}
+			else if (word.size() == boundary && ties > 0) {
+				words[kept++] = word;
+				ties--;
+			}
+		}
+
+		words.resize(kept);
+		length_sort(words.data(), words.size(), descending);
+	}
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "type_aliases.h"
+#include "parallel.h"
+
+
+/**
+ * @brief Fused counting kernel for the new lines, digits, chars, words and numbers of a text.
+ * Everything is computed in one pass with a table driven state machine,
+ * so the counting commands don't have to scan the source on their own.
+ */
+namespace Statistics {
+
+	/**
+	 * @brief Results of the counting.
+	 * Words are the same as in the Tokenizer, numbers are words matching "(^|\s)[0-9]+(?!\w)".
+	 */
+	struct Counters {
+		usize lines = 0;
+		usize digits = 0;
+		usize chars = 0;
+		usize words = 0;
+		usize numbers = 0;
+
+		/**
+		 * @brief Adds the counters of the following part of the text.
+		 *
+		 * @param other - counters of the part
+		 * @return Counters reference
+		 */
+		Counters& operator+=(const Counters& other) {
+			lines += other.lines;
+			digits += other.digits;
+			chars += other.chars;
+			words += other.words;
+			numbers += other.numbers;
+
+			return *this;
+		}
+	};
+
+	namespace __Kernel {
+		/**
+		 * @brief State of the scanner between two bytes.
+		 * Space - outside of a word
+		 * Digits - inside of a word made only of digits so far
+		 * Word - inside of a word that can't be a number anymore
+		 */
+		enum State : u8 {
+			Space = 0,
+			Digits = 1,
+			Word = 2
+		};
+
+		const u8 STATE_MASK = 0x03;
+		const u8 WORD_BIT = 0x04;
+		const u8 NUMBER_BIT = 0x08;
+		const u8 DIGIT_BIT = 0x10;
+		const u8 LINE_BIT = 0x20;
+
+		/**
+		 * @brief Transition table indexed by the state and the byte.
+		 * Each entry holds the next state and the counters to increment.
+		 */
+		struct Table {
+			u8 entries[3][256];
+
+			Table() {
+				for (u32 byte = 0; byte < 256; byte++) {
+					const bool space = byte == ' ' || (byte >= '\t' && byte <= '\r');
+					const bool digit = byte >= '0' && byte <= '9';
+					const bool word_char = digit || byte == '_'
+						|| (byte >= 'a' && byte <= 'z')
+						|| (byte >= 'A' && byte <= 'Z');
+
+					u8 common = 0;
+					if (digit) common |= DIGIT_BIT;
+					if (byte == '\n') common |= LINE_BIT;
+
+					if (space) {
+						entries[Space][byte] = common | Space;
+						entries[Digits][byte] = common | Space | NUMBER_BIT;
+						entries[Word][byte] = common | Space;
+					}
+					else {
+						entries[Space][byte] = common | WORD_BIT | (digit ? Digits : Word);
+						entries[Digits][byte] = common | (digit ? Digits : Word) | (word_char ? 0 : NUMBER_BIT);
+						entries[Word][byte] = common | Word;
+					}
+				}
+			}
+		};
+
+		inline const Table& table() {
+			static const Table instance = Table();
+			return instance;
+		}
+	}
+
+	/**
+	 * @brief Resumable scanner, the text can be fed in any number of parts.
+	 * Words and numbers split between two parts are counted correctly.
+	 */
+	struct Scanner {
+		Counters counters;
+		u8 state = __Kernel::Space;
+
+		/**
+		 * @brief Counts the next part of the text.
+		 *
+		 * @param data - next bytes of the text
+		 * @param size - number of the bytes
+		 */
+		void feed(const char* data, const usize size) {
+			const auto& entries = __Kernel::table().entries;
+
+			usize lines = 0;
+			usize digits = 0;
+			usize words = 0;
+			usize numbers = 0;
+			u8 current = state;
+
+			for (usize i = 0; i < size; i++) {
+				const u8 entry = entries[current][(unsigned char)data[i]];
+
+				current = entry & __Kernel::STATE_MASK;
+				words += (entry & __Kernel::WORD_BIT) != 0;
+				numbers += (entry & __Kernel::NUMBER_BIT) != 0;
+				digits += (entry & __Kernel::DIGIT_BIT) != 0;
+				lines += (entry & __Kernel::LINE_BIT) != 0;
+			}
+
+			state = current;
+			counters.lines += lines;
+			counters.digits += digits;
+			counters.chars += size;
+			counters.words += words;
+			counters.numbers += numbers;
+		}
+
+		/**
+		 * @brief Gets the counters as if the text ended at this point.
+		 *
+		 * @return Counters
+		 */
+		Counters finish() const {
+			Counters result = counters;
+
+			if (state == __Kernel::Digits) {
+				result.numbers++;
+			}
+
+			return result;
+		}
+	};
+
+	/**
+	 * @brief Counts everything in the text on all the cores.
+	 * The text is split at whitespaces, so every part can be counted independently and the results just summed.
+	 *
+	 * @param text - target text
+	 * @param parts - number of the parts to count concurrently
+	 * @return Counters
+	 */
+	inline Counters scan_parallel(const StringView text, const usize parts) {
+		const auto chunks = Parallel::split_at_spaces(text, parts);
+		auto results = Vec<Counters>(chunks.size());
+
+		Parallel::for_each_index(chunks.size(), [&chunks, &results](const usize index) {
+			Scanner scanner;
+			scanner.feed(chunks[index].data(), chunks[index].size());
+
+			results[index] = scanner.finish();
+		});
+
+		Counters counters;
+		for (const Counters& result : results) {
+			counters += result;
+		}
+
+		return counters;
+	}
+
+	/**
+	 * @brief Counts everything in the text in a single pass, split between the cores for the large texts.
+	 *
+	 * @param text - target text
+	 * @return Counters
+	 */
+	inline Counters scan(const StringView text) {
+		const usize parts = Parallel::part_count(text.size());
+
+		if (parts > 1) {
+			return scan_parallel(text, parts);
+		}
+
+		Scanner scanner;
+		scanner.feed(text.data(), text.size());
+
+		return scanner.finish();
+	}
+}
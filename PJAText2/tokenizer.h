@@ -0,0 +1,373 @@
+#pragma once
+
+#include <algorithm>
+
+#include "type_aliases.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PJA_TOKENIZER_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(PJA_TOKENIZER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PJA_TARGET_SSE2 __attribute__((target("sse2")))
+#define PJA_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PJA_TARGET_SSE2
+#define PJA_TARGET_AVX2
+#endif
+
+
+/**
+ * @brief Whitespace tokenizer producing the same "words" as the "(?!\s)[\S]+" regex.
+ * A word is a maximal run of bytes that are not ' ', '\t', '\n', '\v', '\f' or '\r'.
+ * Token boundaries are found 16/32 bytes at a time with SSE2/AVX2 classification masks,
+ * the best implementation is picked once at runtime and falls back to a scalar loop.
+ */
+namespace Tokenizer {
+
+	/**
+	 * @brief List of tokens viewing into the tokenized buffer, no bytes are copied.
+	 * The views are valid as long as the tokenized buffer is alive and unchanged.
+	 */
+	using Tokens = Vec<StringView>;
+
+	namespace __Scan {
+		/**
+		 * @brief Signature of the function returning a whitespace bitmask of the next 64 bytes.
+		 */
+		using MaskFn = u64(*)(const char*);
+
+		/**
+		 * @brief Signature of the function splitting a buffer into tokens.
+		 */
+		using SplitFn = void(*)(const char*, usize, Tokens&);
+
+		/**
+		 * @brief Checks if the byte is a whitespace in the sense of the "\s" regex class.
+		 *
+		 * @param ch - target byte
+		 * @return true - if the byte is a whitespace
+		 * @return false - if the byte is not a whitespace
+		 */
+		inline bool is_space(const char ch) {
+			const unsigned char byte = (unsigned char)ch;
+			return byte == ' ' || (unsigned char)(byte - '\t') <= 4;
+		}
+
+		/**
+		 * @brief Gets the index of the lowest set bit.
+		 *
+		 * @param value - non zero value
+		 * @return index of the lowest set bit
+		 */
+		inline usize lowest_bit(const u64 value) {
+#if defined(__GNUC__) || defined(__clang__)
+			return (usize)__builtin_ctzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			unsigned long index;
+			_BitScanForward64(&index, value);
+			return index;
+#elif defined(_MSC_VER)
+			unsigned long index;
+			if (_BitScanForward(&index, (unsigned long)value)) {
+				return index;
+			}
+			_BitScanForward(&index, (unsigned long)(value >> 32));
+			return index + 32;
+#else
+			usize index = 0;
+			while (!((value >> index) & 1)) {
+				index++;
+			}
+			return index;
+#endif
+		}
+
+		/**
+		 * @brief Byte by byte tokenization, used directly on CPUs without SIMD and for the tails of the vector paths.
+		 *
+		 * @param data - buffer to tokenize
+		 * @param size - size of the buffer
+		 * @param offset - position to start from
+		 * @param in_token - true if a token is open at the offset
+		 * @param start - start of the open token
+		 * @param tokens - collection to append the found tokens into
+		 */
+		inline void split_tail(const char* data, const usize size, usize offset, bool in_token, usize start, Tokens& tokens) {
+			for (; offset < size; offset++) {
+				const bool space = is_space(data[offset]);
+
+				if (in_token && space) {
+					tokens.emplace_back(data + start, offset - start);
+					in_token = false;
+				}
+				else if (!in_token && !space) {
+					start = offset;
+					in_token = true;
+				}
+			}
+
+			if (in_token) {
+				tokens.emplace_back(data + start, size - start);
+			}
+		}
+
+		inline void split_scalar(const char* data, const usize size, Tokens& tokens) {
+			split_tail(data, size, 0, false, 0, tokens);
+		}
+
+		/**
+		 * @brief Tokenizes 64 byte blocks using a whitespace bitmask, and finishes the tail with the scalar path.
+		 * Token starts and ends are the edges of the non-whitespace bitmask, so each block costs one mask and one bit per edge.
+		 *
+		 * @param data - buffer to tokenize
+		 * @param size - size of the buffer
+		 * @param tokens - collection to append the found tokens into
+		 * @param space_mask - function classifying 64 bytes
+		 */
+		inline void split_blocks(const char* data, const usize size, Tokens& tokens, const MaskFn space_mask) {
+			usize offset = 0;
+			usize start = 0;
+			bool in_token = false;
+
+			for (; offset + 64 <= size; offset += 64) {
+				const u64 word = ~space_mask(data + offset);
+				const u64 previous = (word << 1) | (in_token ? 1 : 0);
+				u64 edges = word ^ previous;
+
+				while (edges) {
+					const usize position = offset + lowest_bit(edges);
+
+					if (in_token) {
+						tokens.emplace_back(data + start, position - start);
+					}
+					else {
+						start = position;
+					}
+
+					in_token = !in_token;
+					edges &= edges - 1;
+				}
+			}
+
+			split_tail(data, size, offset, in_token, start, tokens);
+		}
+
+#ifdef PJA_TOKENIZER_X86
+		PJA_TARGET_SSE2 inline u64 space_mask_sse2_16(const char* data) {
+			const __m128i bytes = _mm_loadu_si128((const __m128i*)data);
+			const __m128i spaces = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '));
+			const __m128i shifted = _mm_sub_epi8(bytes, _mm_set1_epi8('\t'));
+			const __m128i controls = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)), shifted);
+
+			return (u64)(u32)_mm_movemask_epi8(_mm_or_si128(spaces, controls));
+		}
+
+		PJA_TARGET_SSE2 inline u64 space_mask_sse2(const char* data) {
+			return space_mask_sse2_16(data)
+				| (space_mask_sse2_16(data + 16) << 16)
+				| (space_mask_sse2_16(data + 32) << 32)
+				| (space_mask_sse2_16(data + 48) << 48);
+		}
+
+		PJA_TARGET_AVX2 inline u64 space_mask_avx2_32(const char* data) {
+			const __m256i bytes = _mm256_loadu_si256((const __m256i*)data);
+			const __m256i spaces = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' '));
+			const __m256i shifted = _mm256_sub_epi8(bytes, _mm256_set1_epi8('\t'));
+			const __m256i controls = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(4)), shifted);
+
+			return (u64)(u32)_mm256_movemask_epi8(_mm256_or_si256(spaces, controls));
+		}
+
+		PJA_TARGET_AVX2 inline u64 space_mask_avx2(const char* data) {
+			return space_mask_avx2_32(data) | (space_mask_avx2_32(data + 32) << 32);
+		}
+
+		inline void split_sse2(const char* data, const usize size, Tokens& tokens) {
+			split_blocks(data, size, tokens, space_mask_sse2);
+		}
+
+		inline void split_avx2(const char* data, const usize size, Tokens& tokens) {
+			split_blocks(data, size, tokens, space_mask_avx2);
+		}
+
+		/**
+		 * @brief Checks if the CPU and the OS support the AVX2 instructions.
+		 *
+		 * @return true - if AVX2 can be used
+		 * @return false - if AVX2 can't be used
+		 */
+		inline bool cpu_has_avx2() {
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7) {
+				return false;
+			}
+
+			__cpuid(info, 1);
+			const bool os_saves_ymm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 6) == 6);
+			if (!os_saves_ymm) {
+				return false;
+			}
+
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2");
+#endif
+		}
+
+		/**
+		 * @brief Checks if the CPU supports the SSE2 instructions.
+		 *
+		 * @return true - if SSE2 can be used
+		 * @return false - if SSE2 can't be used
+		 */
+		inline bool cpu_has_sse2() {
+#if defined(_M_X64) || defined(__x86_64__)
+			return true;
+#elif defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 1);
+			return (info[3] & (1 << 26)) != 0;
+#else
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("sse2");
+#endif
+		}
+#endif
+
+		/**
+		 * @brief Picks the fastest split implementation supported by the running CPU.
+		 *
+		 * @return SplitFn
+		 */
+		inline SplitFn detect() {
+#ifdef PJA_TOKENIZER_X86
+			if (cpu_has_avx2()) {
+				return split_avx2;
+			}
+
+			if (cpu_has_sse2()) {
+				return split_sse2;
+			}
+#endif
+			return split_scalar;
+		}
+	}
+
+	/**
+	 * @brief Splits a buffer into tokens (words) separated by whitespaces.
+	 *
+	 * @param source - buffer to tokenize
+	 * @return Tokens viewing into the source
+	 */
+	inline Tokens split(const StringView source) {
+		static const __Scan::SplitFn split_impl = __Scan::detect();
+
+		auto tokens = Tokens();
+		split_impl(source.data(), source.size(), tokens);
+
+		return tokens;
+	}
+
+	/**
+	 * @brief Calls the callback for every whitespace aligned window of the text, so no word is cut in two.
+	 *
+	 * @tparam F - Type of the callback taking (StringView window)
+	 * @param text - target text
+	 * @param window_size - approximate size of a window
+	 * @param callback - function to call
+	 */
+	template <typename F>
+	void for_each_window(const StringView text, const usize window_size, F callback) {
+		usize begin = 0;
+
+		while (begin < text.size()) {
+			usize end = std::min(begin + window_size, text.size());
+
+			while (end < text.size() && !__Scan::is_space(text[end])) {
+				end++;
+			}
+
+			callback(text.substr(begin, end - begin));
+			begin = end;
+		}
+	}
+
+	/**
+	 * @brief Tokenizer of a text fed in consecutive chunks, like the chunks of a streamed file.
+	 * A word cut between two chunks is carried over and passed to the callback as a whole.
+	 */
+	class ChunkSplitter {
+	private:
+		String partial;
+
+	public:
+		/**
+		 * @brief Tokenizes the next chunk of the text.
+		 * The views passed to the callback are valid only during the call.
+		 *
+		 * @tparam F - Type of the callback taking (StringView word)
+		 * @param data - next bytes of the text
+		 * @param size - number of the bytes
+		 * @param callback - function called with every complete word, in order
+		 */
+		template <typename F>
+		void feed(const char* data, const usize size, F callback) {
+			if (size == 0) {
+				return;
+			}
+
+			const auto tokens = split(StringView(data, size));
+			const bool starts_in_word = !__Scan::is_space(data[0]);
+			const bool ends_in_word = !__Scan::is_space(data[size - 1]);
+
+			usize first = 0;
+			usize last = tokens.size();
+
+			if (!partial.empty()) {
+				if (starts_in_word) {
+					partial.append(tokens[0].data(), tokens[0].size());
+					first = 1;
+
+					if (ends_in_word && tokens.size() == 1) {
+						return;
+					}
+				}
+
+				callback(StringView(partial));
+				partial.clear();
+			}
+
+			if (ends_in_word && last > first) {
+				last--;
+				partial.assign(tokens[last].data(), tokens[last].size());
+			}
+
+			for (usize i = first; i < last; i++) {
+				callback(tokens[i]);
+			}
+		}
+
+		/**
+		 * @brief Passes the word carried from the last chunk to the callback, as the text ended.
+		 *
+		 * @tparam F - Type of the callback taking (StringView word)
+		 * @param callback - function called with the last word
+		 */
+		template <typename F>
+		void finish(F callback) {
+			if (!partial.empty()) {
+				callback(StringView(partial));
+				partial.clear();
+			}
+		}
+	};
+}
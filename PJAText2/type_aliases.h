@@ -1,12 +1,17 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <fstream>
 
 
+using u8 = unsigned char;
+using i8 = signed char;
+
 using u16 = unsigned short int;
 using i16 = short int;
 
@@ -22,6 +27,7 @@ using f64 = double;
 using usize = size_t;
 
 using String = std::string;
+using StringView = std::string_view;
 using StringStream = std::stringstream;
 
 template <typename T>
@@ -30,6 +36,9 @@ using Vec = std::vector<T>;
 template <typename K, typename V>
 using HashMap = std::unordered_map<K, V>;
 
+template <typename T>
+using HashSet = std::unordered_set<T>;
+
 template <typename T, typename U>
 using Pair = std::pair<T, U>;
 
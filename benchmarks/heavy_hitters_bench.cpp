@@ -0,0 +1,174 @@
+/**
+ * @brief Accuracy and throughput benchmark of the bounded memory word frequencies (-hh, -cm).
+ * Words are drawn from a Zipf distribution and compared with the exact counts of the WordCounter.
+ * The process fails if a guarantee of the sketches doesn't hold:
+ * Space-Saving counts have to bound the real counts from both sides, Count-Min can never underestimate.
+ *
+ * Build from the repository's root:
+ * g++ -std=c++17 -O2 -pthread benchmarks/heavy_hitters_bench.cpp -o heavy_hitters_bench
+ * cl /std:c++17 /O2 /EHsc benchmarks\heavy_hitters_bench.cpp
+ *
+ * Usage: heavy_hitters_bench [words] [vocabulary] [exponent]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include "../PJAText2/type_aliases.h"
+#include "../PJAText2/tokenizer.h"
+#include "../PJAText2/hash_table.h"
+#include "../PJAText2/heavy_hitters.h"
+
+
+namespace Bench {
+
+	/**
+	 * @brief Generates a text of the words drawn from a Zipf distribution, "w<rank>" is the word of the given rank.
+	 *
+	 * @param words - number of the words
+	 * @param vocabulary - number of the distinct words to draw from
+	 * @param exponent - exponent of the distribution
+	 * @return text of the words separated by spaces
+	 */
+	String zipf_text(const usize words, const usize vocabulary, const f64 exponent) {
+		auto cumulative = Vec<f64>(vocabulary);
+		f64 sum = 0;
+
+		for (usize rank = 0; rank < vocabulary; rank++) {
+			sum += 1.0 / std::pow((f64)(rank + 1), exponent);
+			cumulative[rank] = sum;
+		}
+
+		std::mt19937_64 generator(42);
+		std::uniform_real_distribution<f64> uniform(0.0, sum);
+
+		String text;
+		text.reserve(words * 8);
+
+		for (usize i = 0; i < words; i++) {
+			const auto rank = std::lower_bound(cumulative.begin(), cumulative.end(), uniform(generator)) - cumulative.begin();
+			text.append("w").append(std::to_string(rank)).append(" ");
+		}
+
+		return text;
+	}
+
+	/**
+	 * @brief Measures the throughput of the callback over all the words.
+	 *
+	 * @return millions of the words per second
+	 */
+	template <typename F>
+	f64 words_per_second(const Tokenizer::Tokens& words, F callback) {
+		const auto start = std::chrono::steady_clock::now();
+
+		for (const StringView word : words) {
+			callback(word);
+		}
+
+		const f64 seconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count();
+		return words.size() / seconds / 1e6;
+	}
+}
+
+
+int main(int argc, char* argv[]) {
+	const usize word_count = argc > 1 ? std::stoull(argv[1]) : 5000000;
+	const usize vocabulary = argc > 2 ? std::stoull(argv[2]) : 200000;
+	const f64 exponent = argc > 3 ? std::stod(argv[3]) : 1.1;
+
+	const String text = Bench::zipf_text(word_count, vocabulary, exponent);
+	const auto words = Tokenizer::split(text);
+	bool failed = false;
+
+	std::cout << "Words: " << words.size() << ", vocabulary: " << vocabulary << ", exponent: " << exponent << "\n\n";
+
+	auto exact = HashTable::WordCounter();
+	const f64 exact_speed = Bench::words_per_second(words, [&exact](const StringView word) {
+		exact.add(word);
+	});
+
+	auto ranked = Vec<Pair<StringView, usize>>();
+	exact.for_each([&ranked](const StringView word, const usize count) {
+		ranked.emplace_back(word, count);
+	});
+
+	std::sort(ranked.begin(), ranked.end(), [](const Pair<StringView, usize>& left, const Pair<StringView, usize>& right) {
+		return left.second > right.second;
+	});
+
+	auto real_count = HashMap<String, usize>();
+	for (const auto& pair : ranked) {
+		real_count[String(pair.first)] = pair.second;
+	}
+
+	std::cout << "Exact WordCounter: " << exact_speed << " M words/s\n\n";
+
+	for (const usize top : { (usize)10, (usize)100 }) {
+		auto summary = HeavyHitters::SpaceSaving(top * HeavyHitters::CAPACITY_FACTOR);
+		const f64 speed = Bench::words_per_second(words, [&summary](const StringView word) {
+			summary.add(word);
+		});
+
+		const auto entries = summary.top(top);
+		auto real_top = HashSet<String>();
+		for (usize i = 0; i < top && i < ranked.size(); i++) {
+			real_top.insert(String(ranked[i].first));
+		}
+
+		usize found = 0;
+		f64 max_error = 0;
+
+		for (const HeavyHitters::Entry& entry : entries) {
+			const usize real = real_count[entry.word];
+
+			found += real_top.count(entry.word);
+			max_error = std::max(max_error, (f64)(entry.count - real) / real);
+
+			if (real > entry.count || real < entry.count - entry.error) {
+				std::cout << "[FAILED] Space-Saving bounds don't hold for " << entry.word << "\n";
+				failed = true;
+			}
+		}
+
+		std::cout << "Space-Saving top " << top << " (" << top * HeavyHitters::CAPACITY_FACTOR << " monitored): "
+			<< speed << " M words/s, recall " << (f64)found / top
+			<< ", max relative error " << max_error << "\n";
+	}
+
+	auto sketch = HeavyHitters::CountMin();
+	const f64 sketch_speed = Bench::words_per_second(words, [&sketch](const StringView word) {
+		sketch.add(word);
+	});
+
+	std::cout << "\nCount-Min: " << sketch_speed << " M words/s\n";
+
+	const usize samples = std::min<usize>(1000, ranked.size());
+	const Pair<const char*, usize> ranges[] = { { "head", 0 }, { "tail", ranked.size() - samples } };
+
+	for (const auto& range : ranges) {
+		f64 total_error = 0;
+		u64 max_error = 0;
+
+		for (usize i = range.second; i < range.second + samples; i++) {
+			const u64 estimate = sketch.estimate(ranked[i].first);
+
+			if (estimate < ranked[i].second) {
+				std::cout << "[FAILED] Count-Min underestimates " << ranked[i].first << "\n";
+				failed = true;
+				continue;
+			}
+
+			total_error += (f64)(estimate - ranked[i].second);
+			max_error = std::max<u64>(max_error, estimate - ranked[i].second);
+		}
+
+		std::cout << "Count-Min " << range.first << " " << samples << " words: mean overestimate " << total_error / samples
+			<< ", max overestimate " << max_error << " (" << 100.0 * max_error / words.size() << "% of the words)\n";
+	}
+
+	return failed ? 1 : 0;
+}